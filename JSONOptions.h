@@ -236,6 +236,17 @@
 #define JSON_ESCAPE_WRITES
 
 
+/**
+ * @def JSON_UTF8
+ *
+ * JSON_UTF8 tells libjson that narrow strings hold UTF-8.  Characters past ascii are written out
+ * as they are instead of being escaped one byte at a time as \u00XX, and \u escapes are read in as
+ * UTF-8.  With JSON_SAFE, text that isn't well formed UTF-8 is rejected when it is parsed.  Without
+ * this, narrow strings are treated as Latin-1.  It can't be used with JSON_UNICODE
+ */
+//#define JSON_UTF8
+
+
 /**
  * @def JSON_COMMENTS
  *
@@ -409,3 +420,26 @@
  * the question for high speed systems.
  */
 #define JSON_SECURITY_MAX_STREAM_OBJECTS 128
+
+
+/**
+ * @def JSON_NO_SIMD
+ *
+ * JSON_NO_SIMD turns off the SSE2 and AVX2 code paths that libjson uses to scan through text many
+ * characters at a time.  They are only used for narrow characters on x86 processors, and the widest
+ * instruction set that the processor supports is picked when the library first needs it.  The output
+ * is the same either way, this is mostly useful for testing or for odd compilers
+ */
+//#define JSON_NO_SIMD
+
+
+/**
+ * @def JSON_NO_THREADS
+ *
+ * JSON_NO_THREADS removes the threads that preparse_parallel uses to fetch the children of a large
+ * array or object at the same time.  Without it libjson needs to be linked with the platform's
+ * thread library, and memory callbacks have to be safe to call from more than one thread at once.
+ * preparse_parallel is still there either way, it just does everything on the calling thread.
+ * Threads are never used with JSON_MEMORY_POOL or JSON_MEMORY_MANAGE
+ */
+//#define JSON_NO_THREADS
@@ -41,6 +41,13 @@
 	#else
 		typedef std::basic_string<json_char, std::char_traits<json_char>, json_allocator<json_char> > json_string;
 	#endif
+
+	/* Lets text be handed in without building a json_string first, only on compilers that have it */
+	#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+		#include <string_view>
+		#define JSON_STRING_VIEW
+		typedef std::basic_string_view<json_char> json_string_view;
+	#endif
 #endif
 #define JSON_MAP(x, y) std::map<x, y, std::less<x>, json_allocator<std::pair<const x, y> > >
 
@@ -153,6 +160,11 @@ typedef void * (*json_realloc_t)(void *, size_t);
 	   #error, JSON_VALIDATE also requires JSON_READ_PRIORITY
     #endif
 #endif
+#ifdef JSON_UTF8
+    #ifdef JSON_UNICODE
+	   #error, JSON_UTF8 is for narrow strings, turn off JSON_UNICODE
+    #endif
+#endif
 
 #define JSON_TEMP_COMMENT_IDENTIFIER JSON_TEXT('#')
 
@@ -55,7 +55,11 @@
     #endif
 
     #define json_nothrow throw()
-    #define json_throws(x) throw(x)
+    #if (__cplusplus >= 201703L)
+	   #define json_throws(x)  /* dynamic exception specifications are gone in C++17 */
+    #else
+	   #define json_throws(x) throw(x)
+    #endif
 
     #ifdef JSON_LESS_MEMORY
 	   #define PACKED(x) :x __attribute__ ((packed))
@@ -17,10 +17,12 @@
     #define JSON_TEXT(s) L ## s
     #define json_strlen wcslen
     #define json_strcmp wcscmp
+    #define json_memchr wmemchr
 #else
     #define json_char char
     #define json_uchar unsigned char
     #ifdef __cplusplus
+	   #include <cstring>  /* json_strlen */
 	   #ifndef JSON_STRING_HEADER
 		  #include <string>
 	   #endif
@@ -30,6 +32,7 @@
     #define JSON_TEXT(s) s
     #define json_strlen strlen
     #define json_strcmp strcmp
+    #define json_memchr memchr
 #endif
 
 
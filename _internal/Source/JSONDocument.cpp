@@ -0,0 +1,384 @@
+#include "JSONDocument.h"
+
+#ifdef JSON_READ_PRIORITY
+
+#include "JSONNode.h"
+#include "JSONWorker.h"
+#include "NumberToString.h"
+
+#ifdef JSON_COMMENTS
+    //comments were turned into #comment# runs by RemoveWhiteSpace, the document doesn't keep them
+    #define SKIP_COMMENTS(p, end)\
+	   while ((p != end) && (*p == JSON_TEMP_COMMENT_IDENTIFIER)){\
+		  while ((++p != end) && (*p != JSON_TEMP_COMMENT_IDENTIFIER)){}\
+		  if (p != end) ++p;\
+	   }
+#else
+    #define SKIP_COMMENTS(p, end) (void)0
+#endif
+
+#ifndef JSON_STRICT
+    #define LETTERCASE(x, y)\
+	   case JSON_TEXT(x):\
+	   case JSON_TEXT(y)
+#else
+    #define LETTERCASE(x, y)\
+	   case JSON_TEXT(x)
+#endif
+
+JSONDocument::JSONDocument(void) json_nothrow : tape(0), tapesize(0), tapecapacity(0), strings(){
+    LIBJSON_CTOR;
+    clear();
+}
+
+JSONDocument::JSONDocument(const json_string & json) json_throws(std::invalid_argument) : tape(0), tapesize(0), tapecapacity(0), strings(){
+    LIBJSON_CTOR;
+    parse(json.data(), json.length());
+}
+
+JSONDocument::JSONDocument(const json_char * json, size_t len) json_throws(std::invalid_argument) : tape(0), tapesize(0), tapecapacity(0), strings(){
+    LIBJSON_CTOR;
+    parse(json, len);
+}
+
+JSONDocument::JSONDocument(const JSONDocument & orig) json_nothrow : tape(0), tapesize(0), tapecapacity(0), strings(orig.strings){
+    LIBJSON_COPY_CTOR;
+    tape = json_malloc<entry>(orig.tapesize);
+    std::memcpy(tape, orig.tape, orig.tapesize * sizeof(entry));
+    tapesize = tapecapacity = orig.tapesize;
+}
+
+JSONDocument & JSONDocument::operator = (const JSONDocument & orig) json_nothrow {
+    if (json_likely(this != &orig)){
+	   tape = json_realloc<entry>(tape, orig.tapesize);
+	   std::memcpy(tape, orig.tape, orig.tapesize * sizeof(entry));
+	   tapesize = tapecapacity = orig.tapesize;
+	   strings = orig.strings;
+    }
+    return *this;
+}
+
+JSONDocument::~JSONDocument(void) json_nothrow {
+    LIBJSON_DTOR;
+    if (tape != 0) libjson_free<entry>(tape);
+}
+
+//an empty document, or one that failed to parse, is a single null
+void JSONDocument::clear(void) json_nothrow {
+    tapesize = 0;
+    clearString(strings);
+    push_back(JSON_NULL, 0, 0);
+}
+
+void JSONDocument::parse(const json_char * json, size_t len) json_throws(std::invalid_argument) {
+    //offsets into the arena are stored as json_index_t to keep the tape small
+    if (json_likely(len < (size_t)((json_index_t)-1))){
+	   size_t stripped;
+	   json_auto<json_char> buffer;
+	   buffer.set(JSONWorker::RemoveWhiteSpace(json, len, stripped, true));
+	   strings.reserve(stripped);
+
+	   const json_char * p = buffer.ptr;
+	   const json_char * const end = buffer.ptr + stripped;
+	   SKIP_COMMENTS(p, end);
+	   if ((p != end) && ((*p == JSON_TEXT('{')) || (*p == JSON_TEXT('[')))){
+		  if (json_likely(parseValue(p, end, 0, 0, 1))){
+			 SKIP_COMMENTS(p, end);
+			 if (json_likely(p == end)) return;
+		  }
+	   }
+    }
+
+    JSON_FAIL(JSON_TEXT("Not JSON!"));
+    clear();
+    #ifndef JSON_NO_EXCEPTIONS
+	   libjson_free<entry>(tape);  //the destructor won't run
+	   tape = 0;
+	   throw std::invalid_argument(json_global(EMPTY_STD_STRING));
+    #endif
+}
+
+//decodes the string at p into the arena, leaving p just past the closing quote
+bool JSONDocument::parseString(const json_char * & p, const json_char * const end, json_index_t & offset, json_index_t & length) json_nothrow {
+    JSON_ASSERT(*p == JSON_TEXT('\"'), JSON_TEXT("parseString not at a quote"));
+    offset = (json_index_t)strings.length();
+    const json_char * run = ++p;
+    //quotes inside of strings were turned into \1 by RemoveWhiteSpace, so the next quote is the end
+    for(; p != end; ++p){
+	   switch(*p){
+		  case JSON_TEXT('\"'):
+			 strings.append(run, p - run);
+			 length = (json_index_t)(strings.length() - offset);
+			 ++p;
+			 return true;
+		  case JSON_TEXT('\\'):
+			 strings.append(run, p - run);
+			 if (json_unlikely(++p == end)) return false;
+			 JSONWorker::SpecialChar(p, end, strings);
+			 if (json_unlikely(p == end)) return false;
+			 run = p + 1;
+			 break;
+	   }
+    }
+    return false;
+}
+
+bool JSONDocument::parseValue(const json_char * & p, const json_char * const end, json_index_t name, json_index_t name_length, size_t depth) json_nothrow {
+    #ifdef JSON_SECURITY_MAX_NEST_LEVEL
+	   if (json_unlikely(depth > JSON_SECURITY_MAX_NEST_LEVEL)){
+		  JSON_FAIL(JSON_TEXT("Exceeded JSON_SECURITY_MAX_NEST_LEVEL"));
+		  return false;
+	   }
+    #endif
+    SKIP_COMMENTS(p, end);
+    if (json_unlikely(p == end)) return false;
+
+    //the tape might move while children are added, so only ever hold on to indexes
+    switch(*p){
+	   case JSON_TEXT('{'): {
+		  const json_index_t res = push_back(JSON_NODE, name, name_length);
+		  json_index_t children = 0;
+		  ++p;
+		  SKIP_COMMENTS(p, end);
+		  if ((p != end) && (*p == JSON_TEXT('}'))){
+			 ++p;
+		  } else {
+			 for(;;){
+				SKIP_COMMENTS(p, end);
+				if (json_unlikely((p == end) || (*p != JSON_TEXT('\"')))) return false;
+				json_index_t member, member_length;
+				if (json_unlikely(!parseString(p, end, member, member_length))) return false;
+				SKIP_COMMENTS(p, end);
+				if (json_unlikely((p == end) || (*p != JSON_TEXT(':')))) return false;
+				if (json_unlikely(!parseValue(++p, end, member, member_length, depth + 1))) return false;
+				++children;
+				SKIP_COMMENTS(p, end);
+				if (json_unlikely(p == end)) return false;
+				if (*p == JSON_TEXT('}')){
+				    ++p;
+				    break;
+				}
+				if (json_unlikely(*p != JSON_TEXT(','))) return false;
+				++p;
+			 }
+		  }
+		  tape[res].size = children;
+		  tape[res].skip = tapesize - res;
+		  return true;
+	   }
+	   case JSON_TEXT('['): {
+		  const json_index_t res = push_back(JSON_ARRAY, name, name_length);
+		  json_index_t children = 0;
+		  ++p;
+		  SKIP_COMMENTS(p, end);
+		  if ((p != end) && (*p == JSON_TEXT(']'))){
+			 ++p;
+		  } else {
+			 for(;;){
+				if (json_unlikely(!parseValue(p, end, 0, 0, depth + 1))) return false;
+				++children;
+				SKIP_COMMENTS(p, end);
+				if (json_unlikely(p == end)) return false;
+				if (*p == JSON_TEXT(']')){
+				    ++p;
+				    break;
+				}
+				if (json_unlikely(*p != JSON_TEXT(','))) return false;
+				++p;
+			 }
+		  }
+		  tape[res].size = children;
+		  tape[res].skip = tapesize - res;
+		  return true;
+	   }
+	   case JSON_TEXT('\"'): {
+		  const json_index_t res = push_back(JSON_STRING, name, name_length);
+		  json_index_t offset, length;
+		  if (json_unlikely(!parseString(p, end, offset, length))) return false;
+		  tape[res].text = offset;
+		  tape[res].size = length;
+		  return true;
+	   }
+	   case JSON_TEXT(']'):
+	   case JSON_TEXT('}'):
+	   case JSON_TEXT(','):
+	   case JSON_TEXT(':'):
+		  return false;
+    }
+
+    //a literal or a number, it runs until the next structural character
+    const json_char * start = p;
+    while ((p != end) && (*p != JSON_TEXT(',')) && (*p != JSON_TEXT(']')) && (*p != JSON_TEXT('}'))
+	   #ifdef JSON_COMMENTS
+		  && (*p != JSON_TEMP_COMMENT_IDENTIFIER)
+	   #endif
+	   ){
+	   ++p;
+    }
+    const size_t length = p - start;
+    json_index_t res;
+    switch(*start){
+	   LETTERCASE('t', 'T'):
+		  JSON_ASSERT_SAFE(json_string(start, length) == json_global(CONST_TRUE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + json_string(start, length)).c_str(), return false;);
+		  res = push_back(JSON_BOOL, name, name_length);
+		  tape[res].value._bool = true;
+		  return true;
+	   LETTERCASE('f', 'F'):
+		  JSON_ASSERT_SAFE(json_string(start, length) == json_global(CONST_FALSE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + json_string(start, length)).c_str(), return false;);
+		  res = push_back(JSON_BOOL, name, name_length);
+		  tape[res].value._bool = false;
+		  return true;
+	   LETTERCASE('n', 'N'):
+		  JSON_ASSERT_SAFE(json_string(start, length) == json_global(CONST_NULL), json_string(json_global(ERROR_UNKNOWN_LITERAL) + json_string(start, length)).c_str(), return false;);
+		  push_back(JSON_NULL, name, name_length);
+		  return true;
+    }
+    JSON_ASSERT_SAFE(NumberToString::isNumeric(json_string(start, length)), json_string(json_global(ERROR_UNKNOWN_LITERAL) + json_string(start, length)).c_str(), return false;);
+    res = push_back(JSON_NUMBER, name, name_length);
+    tape[res].text = (json_index_t)strings.length();
+    tape[res].size = (json_index_t)length;
+    tape[res].value._number = NumberToString::_atof(start, length);
+    strings.append(start, length);
+    return true;
+}
+
+json_string JSONElement::as_string(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    switch(e.type){
+	   case JSON_STRING:
+	   case JSON_NUMBER:
+		  return json_string(doc -> strings.data() + e.text, e.size);
+	   case JSON_BOOL:
+		  return e.value._bool ? json_global(CONST_TRUE) : json_global(CONST_FALSE);
+	   case JSON_NULL:
+		  return json_global(CONST_NULL);
+    }
+    JSON_FAIL(json_global(ERROR_UNDEFINED) + JSON_TEXT("as_string"));
+    return json_global(EMPTY_JSON_STRING);
+}
+
+json_number JSONElement::as_float(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    switch(e.type){
+	   case JSON_NUMBER:
+		  return e.value._number;
+	   #ifdef JSON_CASTABLE
+		  case JSON_NULL:
+			 return (json_number)0.0;
+		  case JSON_BOOL:
+			 return e.value._bool ? (json_number)1.0 : (json_number)0.0;
+		  case JSON_STRING:
+			 return NumberToString::_atof(doc -> strings.data() + e.text, e.size);
+	   #endif
+    }
+    JSON_FAIL(json_global(ERROR_UNDEFINED) + JSON_TEXT("as_float"));
+    return (json_number)0.0;
+}
+
+json_int_t JSONElement::as_int(void) const json_nothrow {
+    JSON_ASSERT(type() != JSON_NUMBER || doc -> tape[entry].value._number == (json_number)((json_int_t)doc -> tape[entry].value._number), json_string(JSON_TEXT("as_int will truncate ")) + as_string());
+    return (json_int_t)as_float();
+}
+
+bool JSONElement::as_bool(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    switch(e.type){
+	   case JSON_BOOL:
+		  return e.value._bool;
+	   #ifdef JSON_CASTABLE
+		  case JSON_NUMBER:
+			 return !_floatsAreEqual(e.value._number, (json_number)0.0);
+		  case JSON_NULL:
+			 return false;
+	   #endif
+    }
+    JSON_FAIL(json_global(ERROR_UNDEFINED) + JSON_TEXT("as_bool"));
+    return false;
+}
+
+//the entry of the pos'th child, or 0 if there isn't one since the root is never a child
+json_index_t JSONElement::child(json_index_t pos) const json_nothrow {
+    const JSONDocument::entry * tape = doc -> tape;
+    if ((tape[entry].type != JSON_NODE) && (tape[entry].type != JSON_ARRAY)) return 0;
+    if (pos >= tape[entry].size) return 0;
+    json_index_t res = entry + 1;
+    while (pos--){
+	   res += tape[res].skip;
+    }
+    return res;
+}
+
+json_index_t JSONElement::find(const json_string & name_t) const json_nothrow {
+    const JSONDocument::entry * tape = doc -> tape;
+    if (tape[entry].type != JSON_NODE) return 0;
+    const json_char * arena = doc -> strings.data();
+    const json_index_t last = entry + tape[entry].skip;
+    for(json_index_t res = entry + 1; res != last; res += tape[res].skip){
+	   if ((tape[res].name_length == name_t.length()) && (std::memcmp(name_t.data(), arena + tape[res].name, name_t.length() * sizeof(json_char)) == 0)){
+		  return res;
+	   }
+    }
+    return 0;
+}
+
+JSONElement JSONElement::at(json_index_t pos) const json_throws(std::out_of_range) {
+    if (json_likely(pos < size())){
+	   return JSONElement(doc, child(pos));
+    }
+    JSON_FAIL(JSON_TEXT("at() out of bounds"));
+    json_throw(std::out_of_range(json_global(EMPTY_STD_STRING)));
+    return *this;
+}
+
+JSONElement JSONElement::at(const json_string & name_t) const json_throws(std::out_of_range) {
+    JSON_ASSERT(type() == JSON_NODE, json_global(ERROR_NON_ITERATABLE) + JSON_TEXT("at"));
+    if (json_index_t res = find(name_t)){
+	   return JSONElement(doc, res);
+    }
+    JSON_FAIL(json_string(JSON_TEXT("at could not find child by name: ")) + name_t);
+    json_throw(std::out_of_range(json_global(EMPTY_STD_STRING)));
+    return *this;
+}
+
+JSONElement JSONElement::operator[](json_index_t pos) const json_nothrow {
+    JSON_ASSERT(pos < size(), JSON_TEXT("[] is out of bounds"));
+    return JSONElement(doc, child(pos));
+}
+
+JSONElement JSONElement::operator[](const json_string & name_t) const json_nothrow {
+    JSON_ASSERT(type() == JSON_NODE, json_global(ERROR_NON_ITERATABLE) + JSON_TEXT("[]"));
+    const json_index_t res = find(name_t);
+    JSON_ASSERT(res != 0, json_string(JSON_TEXT("[] could not find child by name: ")) + name_t);
+    return JSONElement(doc, res);
+}
+
+JSONNode JSONElement::to_node(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    switch(e.type){
+	   case JSON_NODE:
+	   case JSON_ARRAY: {
+		  JSONNode res(e.type);
+		  res.set_name(name());
+		  res.reserve(e.size);
+		  const json_index_t last = entry + e.skip;
+		  for(json_index_t i = entry + 1; i != last; i += doc -> tape[i].skip){
+			 res.push_back(JSONElement(doc, i).to_node());
+		  }
+		  return res;
+	   }
+	   case JSON_STRING:
+		  return JSONNode(name(), as_string());
+	   case JSON_NUMBER: {  //made from the lexeme so that it's written back the same way that it was read
+		  JSONNode res(JSONWorker::NumberNode(doc -> strings.data() + e.text, e.size));
+		  res.set_name(name());
+		  return res;
+	   }
+	   case JSON_BOOL:
+		  return JSONNode(name(), e.value._bool);
+    }
+    JSONNode res(JSON_NULL);
+    res.set_name(name());
+    return res;
+}
+
+#endif
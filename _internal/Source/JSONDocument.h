@@ -0,0 +1,183 @@
+#ifndef LIBJSON_GUARD_DOCUMENT_H
+#define LIBJSON_GUARD_DOCUMENT_H
+
+#include "JSONDebug.h"
+#include "JSONMemory.h"
+#include "JSONGlobals.h"
+#include <stdexcept>
+
+/*
+ *	A parsed JSONNode tree costs a JSONNode, an internalJSONNode and a
+ *	children array for every value, and reading it means chasing pointers
+ *	through all three.  A JSONDocument is for text that is only ever going to
+ *	be read: the whole parse is stored in one contiguous tape of entries, in
+ *	document order, and every string, name and number lexeme is copied into a
+ *	single string arena.  Each entry knows how many entries it spans, so
+ *	hopping to the next sibling is one addition no matter how deeply nested
+ *	the current value is.
+ *
+ *	JSONElements are small views into a document, they mirror the read only
+ *	side of JSONNode and must not outlive the document they came from.  Use
+ *	to_node when something needs to be changed.
+ */
+
+#ifdef JSON_READ_PRIORITY
+
+class JSONNode; //foreward declaration
+class JSONDocument;
+
+class JSONElement {
+public:
+    inline char type(void) const json_nothrow json_read_priority;
+    inline json_index_t size(void) const json_nothrow json_read_priority;
+    inline bool empty(void) const json_nothrow json_read_priority;
+    inline json_string name(void) const json_nothrow json_read_priority;
+
+    json_string as_string(void) const json_nothrow json_read_priority;
+    json_int_t as_int(void) const json_nothrow json_read_priority;
+    json_number as_float(void) const json_nothrow json_read_priority;
+    bool as_bool(void) const json_nothrow json_read_priority;
+
+    JSONElement at(json_index_t pos) const json_throws(std::out_of_range) json_read_priority;
+    JSONElement at(const json_string & name_t) const json_throws(std::out_of_range) json_read_priority;
+    JSONElement operator[](json_index_t pos) const json_nothrow json_read_priority;
+    JSONElement operator[](const json_string & name_t) const json_nothrow json_read_priority;
+
+    //copies the element and everything under it into a tree that can be modified
+    JSONNode to_node(void) const json_nothrow json_read_priority;
+
+    #ifdef JSON_ITERATORS
+	   class const_iterator;
+
+	   inline const_iterator begin(void) const json_nothrow;
+	   inline const_iterator end(void) const json_nothrow;
+    #endif
+JSON_PRIVATE
+    JSONElement(const JSONDocument * doc_t, json_index_t entry_t) json_nothrow : doc(doc_t), entry(entry_t){}
+    json_index_t find(const json_string & name_t) const json_nothrow json_read_priority;
+    json_index_t child(json_index_t pos) const json_nothrow json_read_priority;
+
+    const JSONDocument * doc;
+    json_index_t entry;
+    friend class JSONDocument;
+};
+
+#ifdef JSON_ITERATORS
+    class JSONElement::const_iterator {
+    public:
+	   inline const_iterator & operator ++(void) json_nothrow {
+		  next();
+		  return *this;
+	   }
+	   inline const_iterator operator ++(int) json_nothrow {
+		  const_iterator result(*this);
+		  next();
+		  return result;
+	   }
+	   inline const JSONElement & operator *(void) const json_nothrow { return current; }
+	   inline const JSONElement * operator ->(void) const json_nothrow { return &current; }
+	   inline bool operator == (const const_iterator & other) const json_nothrow { return current.entry == other.current.entry; }
+	   inline bool operator != (const const_iterator & other) const json_nothrow { return current.entry != other.current.entry; }
+    JSON_PRIVATE
+	   const_iterator(const JSONDocument * doc_t, json_index_t entry_t) json_nothrow : current(doc_t, entry_t){}
+	   inline void next(void) json_nothrow;
+	   JSONElement current;
+	   friend class JSONElement;
+    };
+#endif
+
+class JSONDocument {
+public:
+	LIBJSON_OBJECT(JSONDocument);
+    JSONDocument(void) json_nothrow;
+    explicit JSONDocument(const json_string & json) json_throws(std::invalid_argument);
+    JSONDocument(const json_char * json, size_t len) json_throws(std::invalid_argument);
+    JSONDocument(const JSONDocument & orig) json_nothrow;
+    JSONDocument & operator = (const JSONDocument & orig) json_nothrow;
+    ~JSONDocument(void) json_nothrow;
+
+    inline JSONElement root(void) const json_nothrow {
+	   return JSONElement(this, 0);
+    }
+JSON_PRIVATE
+    struct entry {
+	   json_index_t skip;	  //how many entries this value spans, itself included
+	   json_index_t size;	  //children of containers, arena length of strings and numbers
+	   json_index_t text;	  //where strings and number lexemes start in the arena
+	   json_index_t name;	  //where the member name starts in the arena
+	   json_index_t name_length;
+	   union {
+		  json_number _number;
+		  bool _bool;
+	   } value;
+	   char type;
+    };
+
+    void parse(const json_char * json, size_t len) json_throws(std::invalid_argument) json_read_priority;
+    bool parseValue(const json_char * & p, const json_char * const end, json_index_t name, json_index_t name_length, size_t depth) json_nothrow json_read_priority;
+    bool parseString(const json_char * & p, const json_char * const end, json_index_t & offset, json_index_t & length) json_nothrow json_read_priority;
+    void clear(void) json_nothrow;
+
+    inline json_index_t push_back(char type, json_index_t name, json_index_t name_length) json_nothrow {
+	   if (json_unlikely(tapesize == tapecapacity)){
+		  tapecapacity = (tapecapacity == 0) ? 16 : tapecapacity << 1;
+		  tape = json_realloc<entry>(tape, tapecapacity);
+	   }
+	   entry & res = tape[tapesize];
+	   res.skip = 1;
+	   res.size = 0;
+	   res.text = 0;
+	   res.name = name;
+	   res.name_length = name_length;
+	   res.value._number = (json_number)0.0;
+	   res.type = type;
+	   return tapesize++;
+    }
+
+    entry * tape;
+    json_index_t tapesize;
+    json_index_t tapecapacity;
+    json_string strings;
+    friend class JSONElement;
+    #ifdef JSON_ITERATORS
+	   friend class JSONElement::const_iterator;
+    #endif
+};
+
+inline char JSONElement::type(void) const json_nothrow {
+    return doc -> tape[entry].type;
+}
+
+inline json_index_t JSONElement::size(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    return ((e.type == JSON_NODE) || (e.type == JSON_ARRAY)) ? e.size : 0;
+}
+
+inline bool JSONElement::empty(void) const json_nothrow {
+    return size() == 0;
+}
+
+inline json_string JSONElement::name(void) const json_nothrow {
+    const JSONDocument::entry & e = doc -> tape[entry];
+    return json_string(doc -> strings.data() + e.name, e.name_length);
+}
+
+#ifdef JSON_ITERATORS
+    inline void JSONElement::const_iterator::next(void) json_nothrow {
+	   current.entry += current.doc -> tape[current.entry].skip;
+    }
+
+    inline JSONElement::const_iterator JSONElement::begin(void) const json_nothrow {
+	   JSON_ASSERT((type() == JSON_NODE) || (type() == JSON_ARRAY), json_global(ERROR_NON_ITERATABLE) + JSON_TEXT("begin"));
+	   return const_iterator(doc, entry + 1);
+    }
+
+    inline JSONElement::const_iterator JSONElement::end(void) const json_nothrow {
+	   JSON_ASSERT((type() == JSON_NODE) || (type() == JSON_ARRAY), json_global(ERROR_NON_ITERATABLE) + JSON_TEXT("end"));
+	   return const_iterator(doc, entry + doc -> tape[entry].skip);
+    }
+#endif
+
+#endif
+
+#endif
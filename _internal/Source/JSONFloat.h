@@ -0,0 +1,60 @@
+#ifndef JSON_FLOAT_H
+#define JSON_FLOAT_H
+
+#include "JSONDebug.h"
+
+/*
+ *	Turns decimal number text into the json_number that is closest to it,
+ *	rounded exactly the way that the compiler would round the same literal.
+ *	Up to 19 significant digits are gathered into a 64 bit integer, numbers
+ *	small enough to be exact as a double are then done with one multiply or
+ *	divide, and the rest are done by multiplying by a 128 bit approximation
+ *	of the power of ten (Eisel and Lemire's algorithm), which is always
+ *	enough to get the right bits.  Only numbers with more than 19 digits
+ *	that land right on the edge between two doubles, and text that isn't a
+ *	plain decimal number at all, like hex, are handed to strtod instead.
+ *
+ *	It works on the json_chars themselves, so wide text never needs to be
+ *	narrowed into a temporary first.
+ *
+ *	Going the other way, write() puts out as few digits as it takes for the
+ *	number to read back exactly, with an exponent once it gets very big or
+ *	very small, instead of the six decimal places that printf would give.
+ */
+
+class JSONFloat {
+public:
+    //the number in the text, which doesn't need to be null terminated
+    static json_number parse(const json_char * num, size_t len) json_nothrow;
+
+    /*
+	   digits * 10^exponent, digits being the first 19 significant digits of
+	   the number and truncated saying that there were more that weren't all
+	   zeros, num and len are the text that it came from in case it's needed
+    */
+    static json_number compute(bool negative, unsigned long long digits, long exponent, bool truncated, const json_char * num, size_t len) json_nothrow;
+
+    //appends the shortest text that reads back as value, a float only gets as many digits as a float needs
+    template<typename T>
+    static void write(T value, json_string & out) json_nothrow;
+
+    //adds the next digit onto what compute needs, only the first 19 significant ones are kept since that's all that always fits
+    static inline void digit(unsigned long long & digits, int & count, long & exponent, bool & truncated, unsigned int value, bool fraction) json_nothrow {
+	   if (json_likely(count < 19)){
+		  if (digits | value){  //leading zeros aren't significant
+			 digits = digits * 10 + value;
+			 ++count;
+		  }
+		  if (fraction) --exponent;
+	   } else {
+		  truncated |= (value != 0);
+		  if (!fraction) ++exponent;
+	   }
+    }
+JSON_PRIVATE
+    static json_number slow(const json_char * num, size_t len) json_nothrow;
+private:
+    JSONFloat(void);
+};
+
+#endif
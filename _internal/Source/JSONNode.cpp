@@ -1,4 +1,5 @@
 #include "JSONNode.h"
+#include "JSONWorker.h"  //for JSON pointers
 
 #define IMPLEMENT_CTOR(type)\
     JSONNode::JSONNode(const json_string & name_t, type value_t) json_nothrow : internal(internalJSONNode::newInternal()){\
@@ -211,6 +212,42 @@ const JSONNode & JSONNode::at(const json_string & name_t) const json_throws(std:
     json_throw(std::out_of_range(json_global(EMPTY_STD_STRING)));
 }
 
+JSONNode JSONNode::at_pointer(const json_string & pointer) const json_throws(std::logic_error) {
+    JSON_CHECK_INTERNAL();
+    const JSONNode * current = this;
+    json_string token;
+    for(size_t pos = 0; pos < pointer.length();){
+	   #if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY) && !defined(JSON_COMMENTS)
+		  //the rest of the path is still text, so skip through it instead of fetching everything on the way
+		  const internalJSONNode * in = current -> internal;
+		  if (!in -> Fetched() && in -> isContainer()){
+			 return JSONWorker::extract(in -> _unparsed.data(), in -> _unparsed.length(), pointer, pos);
+		  }
+	   #endif
+	   if (json_unlikely(!JSONWorker::PointerToken(pointer, pos, token))){
+		  json_throw(std::invalid_argument(json_global(EMPTY_STD_STRING)));
+	   }
+	   switch(current -> type()){
+		  case JSON_NODE:
+			 if (JSONNode ** res = current -> internal -> at(token)){
+				current = *res;
+				continue;
+			 }
+			 break;
+		  case JSON_ARRAY:{
+			 json_index_t index;
+			 if (JSONWorker::PointerIndex(token, index) && (index < current -> internal -> size())){
+				current = &(*current)[index];
+				continue;
+			 }
+			 break;
+		  }
+	   }
+	   json_throw(std::out_of_range(json_global(EMPTY_STD_STRING)));
+    }
+    return *current;
+}
+
 #ifdef JSON_CASE_INSENSITIVE_FUNCTIONS
     JSONNode & JSONNode::at_nocase(const json_string & name_t) json_throws(std::out_of_range) {
 	   JSON_CHECK_INTERNAL();
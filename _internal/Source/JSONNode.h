@@ -226,6 +226,19 @@ public:
          * Normally node values are lazy-parsed, so cycles aren't wasted parsing unused elements.
          */
         void preparse(void) json_nothrow json_read_priority;
+
+        /**
+         * @brief Fully parses the node up-front, spreading its children over several threads.
+         *
+         * This level is parsed on the calling thread, then each child is parsed, along with
+         * everything under it, by whichever thread is free next.  This is for very large arrays
+         * and objects, small ones are not worth starting threads for.  Without threads
+         * (see `JSON_NO_THREADS`) it is the same as `preparse`.
+         *
+         * @param threads   How many threads to use, including the calling one. 0 uses one
+         *                  for every processor.
+         */
+        void preparse_parallel(unsigned int threads = 0) json_nothrow json_read_priority;
 #   endif
 
     /**
@@ -354,6 +367,23 @@ public:
      */
     const JSONNode & at(const json_string & name_t) const json_throws(std::out_of_range);
 
+    /**
+     * @brief Gets the value that a JSON pointer (RFC 6901) such as `/user/profile/id` refers to.
+     *
+     * Parts of the tree that haven't been parsed yet are not parsed to find it, the value is
+     * found by skipping through their text instead, and is the only thing that gets a node.
+     * Because of that the result is a copy rather than a reference into this node.
+     *
+     * @param pointer The JSON pointer, an empty one is this node.
+     *
+     * @throws std::out_of_range If there is nothing at the pointer.
+     * @throws std::invalid_argument If the pointer is malformed, or the text on the way to the
+     *                               value is not valid JSON.
+     *
+     * @return A copy of the value that the pointer refers to.
+     */
+    JSONNode at_pointer(const json_string & pointer) const json_throws(std::logic_error);
+
 #   ifdef JSON_CASE_INSENSITIVE_FUNCTIONS
         /**
          * @brief Gets the node with a key matching the one given, ignoring case.
@@ -747,7 +777,7 @@ JSON_PRIVATE
     static JSONNode * newJSONNode(internalJSONNode * internal_t) json_hot;
     #ifdef JSON_READ_PRIORITY
        //used by JSONWorker
-       JSONNode(const json_string & unparsed) json_nothrow : internal(internalJSONNode::newInternal(unparsed)){ //root, specialized because it can only be array or node
+       JSONNode(const json_shared_string & unparsed) json_nothrow : internal(internalJSONNode::newInternal(unparsed)){ //root, specialized because it can only be array or node
           LIBJSON_CTOR;
        }
     #endif
@@ -1146,6 +1176,11 @@ inline void JSONNode::decRef(void) json_nothrow { //decrements internal's counte
        JSON_CHECK_INTERNAL();
        internal -> preparse();
     }
+
+    inline void JSONNode::preparse_parallel(unsigned int threads) json_nothrow {
+       JSON_CHECK_INTERNAL();
+       internal -> preparse_parallel(threads);
+    }
 #endif
 
 #ifdef JSON_DEBUG
@@ -57,42 +57,11 @@ inline bool isHex(json_char c) json_nothrow {
 		  ((c >= JSON_TEXT('a')) && (c <= JSON_TEXT('f'))));
 }
 
-#ifdef JSON_STRICT
-	#include "NumberToString.h"
-#endif
+#include "JSONWorker.h"
 
-json_number FetchNumber(const json_string & _string) json_nothrow;
-json_number FetchNumber(const json_string & _string) json_nothrow {
-    #ifdef JSON_STRICT
-	   return NumberToString::_atof(_string.c_str());
-    #else
-	   #ifdef JSON_UNICODE
-		  const size_t len = _string.length();
-		  #if defined(_MSC_VER) && defined(JSON_SAFE)
-			 const size_t bytes = (len * (sizeof(json_char) / sizeof(char))) + 1;
-			 json_auto<char> temp(bytes);
-			 size_t res;
-			 errno_t err = std::wcstombs_s(&res, temp.ptr, bytes, _string.c_str(), len);
-			 if (err != 0){
-				return (json_number)0.0;
-			 }
-		  #elif defined(JSON_SAFE)
-			 const size_t bytes = (len * (sizeof(json_char) / sizeof(char))) + 1;
-			 json_auto<char> temp(bytes);
-			 size_t res = std::wcstombs(temp.ptr, _string.c_str(), len);
-			 if (res == (size_t)-1){  //-1 is error code for this function
-				return (json_number)0.0;
-			 }
-		  #else
-			 json_auto<char> temp(len + 1);
-			 size_t res = std::wcstombs(temp.ptr, _string.c_str(), len);
-		  #endif
-		  temp.ptr[res] = JSON_TEXT('\0');
-		  return (json_number)std::atof(temp.ptr);
-	   #else
-		  return (json_number)std::atof(_string.c_str());
-	   #endif
-    #endif
+JSONNode FetchNumber(const json_string & _string) json_nothrow;
+JSONNode FetchNumber(const json_string & _string) json_nothrow {
+    return JSONWorker::NumberNode(_string.data(), _string.length());  //the text is kept so that it's written back the same
 }
 
 JSONNode JSONPreparse::isValidNumber(json_string::const_iterator & ptr, json_string::const_iterator & end){
@@ -155,7 +124,7 @@ JSONNode JSONPreparse::isValidNumber(json_string::const_iterator & ptr, json_str
 			 #ifndef JSON_STRICT
 			 case JSON_TEXT('x'):
 				while(isHex(*++ptr)){};
-				return JSONNode(json_global(EMPTY_JSON_STRING), FetchNumber(json_string(start, end - 1)));
+				return FetchNumber(json_string(start, end - 1));
 			 #ifdef JSON_OCTAL
 			 #ifdef __GNUC__
 				case JSON_TEXT('0') ... JSON_TEXT('7'):  //octal
@@ -171,7 +140,7 @@ JSONNode JSONPreparse::isValidNumber(json_string::const_iterator & ptr, json_str
 			 #endif
 				while((*++ptr >= JSON_TEXT('0')) && (*ptr <= JSON_TEXT('7'))){};
 				if ((*ptr != JSON_TEXT('8')) && (*ptr != JSON_TEXT('9'))){
-				    return JSONNode(json_global(EMPTY_JSON_STRING), FetchNumber(json_string(start, ptr - 1)));
+				    return FetchNumber(json_string(start, ptr - 1));
 				}
 				throw false;
 			 case JSON_TEXT('8'):
@@ -212,7 +181,7 @@ JSONNode JSONPreparse::isValidNumber(json_string::const_iterator & ptr, json_str
 				break;
 			 #endif
 			 default:  //just a 0
-				return JSONNode(json_global(EMPTY_JSON_STRING), FetchNumber(json_string(start, ptr - 1)));;
+				return FetchNumber(json_string(start, ptr - 1));;
 		  }
 		  break;
 	   default:
@@ -271,7 +240,7 @@ JSONNode JSONPreparse::isValidNumber(json_string::const_iterator & ptr, json_str
 		  #endif
 			 break;
 		  default:
-			 return JSONNode(json_global(EMPTY_JSON_STRING), FetchNumber(json_string(start, ptr)));;
+			 return FetchNumber(json_string(start, ptr));;
 	   }
 	   ++ptr;
     }
@@ -0,0 +1,349 @@
+#include "JSONReader.h"
+
+#ifdef JSON_READ_PRIORITY
+
+#include "JSONWorker.h"
+#include "NumberToString.h"
+
+#ifndef JSON_STRICT
+    #define LOWERCASE(ch) ((ch) | 0x20)  //true, false and null can be any case in libjson
+    #define LETTERCASE(x, y)\
+	   case JSON_TEXT(x):\
+	   case JSON_TEXT(y)
+#else
+    #define LOWERCASE(ch) (ch)
+    #define LETTERCASE(x, y)\
+	   case JSON_TEXT(x)
+#endif
+
+JSONReader::JSONReader(const json_char * json, size_t len) json_nothrow : end(json + len), start(json), after(json), stack(0), stacksize(0), stackcapacity(0), type(invalid), escaped(false), begun(false){
+    LIBJSON_CTOR;
+    #ifdef JSON_SECURITY_MAX_STRING_LENGTH
+	   if (json_unlikely(len > JSON_SECURITY_MAX_STRING_LENGTH)){
+		  JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+		  begun = true;
+	   }
+    #endif
+}
+
+JSONReader::JSONReader(const json_char * json) json_nothrow : end(json + json_strlen(json)), start(json), after(json), stack(0), stacksize(0), stackcapacity(0), type(invalid), escaped(false), begun(false){
+    LIBJSON_CTOR;
+    #ifdef JSON_SECURITY_MAX_STRING_LENGTH
+	   if (json_unlikely((size_t)(end - json) > JSON_SECURITY_MAX_STRING_LENGTH)){
+		  JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+		  begun = true;
+	   }
+    #endif
+}
+
+JSONReader::JSONReader(const json_string & json) json_nothrow : end(json.data() + json.length()), start(json.data()), after(json.data()), stack(0), stacksize(0), stackcapacity(0), type(invalid), escaped(false), begun(false){
+    LIBJSON_CTOR;
+    #ifdef JSON_SECURITY_MAX_STRING_LENGTH
+	   if (json_unlikely(json.length() > JSON_SECURITY_MAX_STRING_LENGTH)){
+		  JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+		  begun = true;
+	   }
+    #endif
+}
+
+JSONReader::~JSONReader(void) json_nothrow {
+    LIBJSON_DTOR;
+    if (stack != 0) libjson_free<json_char>(stack);
+}
+
+JSONReader::token JSONReader::fail(void) json_nothrow {
+    start = after = end;
+    return type = invalid;
+}
+
+void JSONReader::push(json_char ch) json_nothrow {
+    if (json_unlikely(stacksize == stackcapacity)){
+	   stackcapacity = (stackcapacity == 0) ? 16 : stackcapacity << 1;
+	   stack = json_realloc<json_char>(stack, stackcapacity);
+    }
+    stack[stacksize++] = ch;
+}
+
+const json_char * JSONReader::skipWhiteSpace(const json_char * p) const json_nothrow {
+    while (p != end){
+	   switch(*p){
+		  case JSON_TEXT(' '):
+		  case JSON_TEXT('\t'):
+		  case JSON_TEXT('\n'):
+		  case JSON_TEXT('\r'):
+			 ++p;
+			 break;
+		  #ifndef JSON_STRICT
+			 case JSON_TEXT('/'):  //a C comment
+				if ((p + 1 != end) && (*(p + 1) == JSON_TEXT('*'))){
+				    for(p += 2; (p != end) && ((*p != JSON_TEXT('*')) || (p + 1 == end) || (*(p + 1) != JSON_TEXT('/'))); ++p){}
+				    if (p != end) p += 2;
+				    break;
+				}
+				if ((p + 1 == end) || (*(p + 1) != JSON_TEXT('/'))) return p;  //a stray /, let the caller choke on it
+				//a single line comment, same as a bash one
+			 case JSON_TEXT('#'):  //a bash comment
+				while ((++p != end) && (*p != JSON_TEXT('\n'))){}
+				break;
+		  #endif
+		  default:
+			 return p;
+	   }
+    }
+    return p;
+}
+
+//p is on the opening quote, returns what's after the closing one, or null if there isn't one
+const json_char * JSONReader::endOfString(const json_char * p, bool & esc) const json_nothrow {
+    esc = false;
+    while (++p != end){
+	   switch(*p){
+		  case JSON_TEXT('\"'):
+			 return p + 1;
+		  case JSON_TEXT('\\'):
+			 esc = true;
+			 if (json_unlikely(++p == end)) return 0;
+			 break;
+	   }
+    }
+    return 0;
+}
+
+/*
+    p is on the opening bracket, returns what's after its closing one, or null
+    if the text runs out first.  Like FindNextRelevant, this only counts
+    brackets and hops over strings, it doesn't care which kind of bracket
+    closes which, valid text never mixes them up
+*/
+const json_char * JSONReader::endOfContainer(const json_char * p) const json_nothrow {
+    size_t level = 1;
+    bool esc;
+    while (++p != end){
+	   switch(*p){
+		  case JSON_TEXT('{'):
+		  case JSON_TEXT('['):
+			 ++level;
+			 break;
+		  case JSON_TEXT('}'):
+		  case JSON_TEXT(']'):
+			 if (--level == 0) return p + 1;
+			 break;
+		  case JSON_TEXT('\"'):
+			 p = endOfString(p, esc);
+			 if (json_unlikely(p == 0)) return 0;
+			 --p;
+			 break;
+		  #ifndef JSON_STRICT
+			 case JSON_TEXT('/'):
+			 case JSON_TEXT('#'):{  //so that brackets in comments don't count
+				const json_char * next = skipWhiteSpace(p);
+				if (next != p) p = next - 1;
+				break;
+			 }
+		  #endif
+	   }
+    }
+    return 0;
+}
+
+bool JSONReader::literal(const json_char * p, const json_char * word, size_t len) const json_nothrow {
+    if (json_unlikely((size_t)(end - p) < len)) return false;
+    for(size_t i = 0; i < len; ++i){
+	   if (LOWERCASE(p[i]) != word[i]) return false;
+    }
+    return true;
+}
+
+//p is on the first character of a value
+JSONReader::token JSONReader::value(const json_char * p) json_nothrow {
+    if (json_unlikely(p == end)) return fail();
+    start = p;
+    switch(*p){
+	   case JSON_TEXT('{'):
+		  after = p + 1;
+		  return type = start_object;
+	   case JSON_TEXT('['):
+		  after = p + 1;
+		  return type = start_array;
+	   case JSON_TEXT('\"'):
+		  after = endOfString(p, escaped);
+		  if (json_unlikely(after == 0)) return fail();
+		  return type = string;
+	   LETTERCASE('t', 'T'):
+		  if (json_unlikely(!literal(p, JSON_TEXT("true"), 4))) return fail();
+		  after = p + 4;
+		  return type = boolean;
+	   LETTERCASE('f', 'F'):
+		  if (json_unlikely(!literal(p, JSON_TEXT("false"), 5))) return fail();
+		  after = p + 5;
+		  return type = boolean;
+	   LETTERCASE('n', 'N'):
+		  if (json_unlikely(!literal(p, JSON_TEXT("null"), 4))) return fail();
+		  after = p + 4;
+		  return type = null_value;
+    }
+
+    //a number, it runs until something that can come after a value
+    #ifdef JSON_STRICT
+	   if (json_unlikely((*p != JSON_TEXT('-')) && ((*p < JSON_TEXT('0')) || (*p > JSON_TEXT('9'))))) return fail();
+    #else
+	   if (json_unlikely((*p != JSON_TEXT('-')) && (*p != JSON_TEXT('+')) && (*p != JSON_TEXT('.')) && ((*p < JSON_TEXT('0')) || (*p > JSON_TEXT('9'))))) return fail();
+    #endif
+    for(after = p + 1; after != end; ++after){
+	   switch(*after){
+		  case JSON_TEXT(','):
+		  case JSON_TEXT('}'):
+		  case JSON_TEXT(']'):
+		  case JSON_TEXT(' '):
+		  case JSON_TEXT('\t'):
+		  case JSON_TEXT('\n'):
+		  case JSON_TEXT('\r'):
+		  #ifndef JSON_STRICT
+			 case JSON_TEXT('/'):
+			 case JSON_TEXT('#'):
+		  #endif
+			 return type = number;
+	   }
+    }
+    return type = number;
+}
+
+JSONReader::token JSONReader::next(void) json_nothrow {
+    if (json_unlikely(!begun)){
+	   begun = true;
+	   return value(skipWhiteSpace(after));
+    }
+    if (json_unlikely((type == invalid) || (type == end_of_input))) return type;
+
+    const json_char * p = skipWhiteSpace(after);
+    switch(type){
+	   case start_object:
+		  if (after != start + 1) break;  //skipped, so it's a finished value
+		  #ifdef JSON_SECURITY_MAX_NEST_LEVEL
+			 if (json_unlikely(stacksize >= JSON_SECURITY_MAX_NEST_LEVEL)){
+				JSON_FAIL(JSON_TEXT("Exceeded JSON_SECURITY_MAX_NEST_LEVEL"));
+				return fail();
+			 }
+		  #endif
+		  push(JSON_TEXT('{'));
+		  if ((p != end) && (*p == JSON_TEXT('}'))) break;
+		  goto name;
+	   case start_array:
+		  if (after != start + 1) break;
+		  #ifdef JSON_SECURITY_MAX_NEST_LEVEL
+			 if (json_unlikely(stacksize >= JSON_SECURITY_MAX_NEST_LEVEL)){
+				JSON_FAIL(JSON_TEXT("Exceeded JSON_SECURITY_MAX_NEST_LEVEL"));
+				return fail();
+			 }
+		  #endif
+		  push(JSON_TEXT('['));
+		  if ((p != end) && (*p == JSON_TEXT(']'))) break;
+		  return value(p);
+	   case key:
+		  if (json_unlikely((p == end) || (*p != JSON_TEXT(':')))) return fail();
+		  return value(skipWhiteSpace(p + 1));
+	   default:
+		  break;
+    }
+
+    //a whole value is behind the cursor, so this is either a separator, or the end of a container or the text
+    if (stacksize == 0){
+	   if (json_likely(p == end)){
+		  start = after = end;
+		  return type = end_of_input;
+	   }
+	   return fail();
+    }
+    if (json_unlikely(p == end)) return fail();
+    switch(*p){
+	   case JSON_TEXT(','):
+		  p = skipWhiteSpace(p + 1);
+		  if (stack[stacksize - 1] == JSON_TEXT('[')) return value(p);
+		  goto name;
+	   case JSON_TEXT('}'):
+		  if (json_unlikely(stack[--stacksize] != JSON_TEXT('{'))) return fail();
+		  start = p;
+		  after = p + 1;
+		  return type = end_object;
+	   case JSON_TEXT(']'):
+		  if (json_unlikely(stack[--stacksize] != JSON_TEXT('['))) return fail();
+		  start = p;
+		  after = p + 1;
+		  return type = end_array;
+    }
+    return fail();
+
+    name:
+    if (json_unlikely((p == end) || (*p != JSON_TEXT('\"')))) return fail();
+    start = p;
+    after = endOfString(p, escaped);
+    if (json_unlikely(after == 0)) return fail();
+    return type = key;
+}
+
+void JSONReader::skip_value(void) json_nothrow {
+    switch(type){
+	   case key:
+		  if (next() != invalid) skip_value();
+		  break;
+	   case start_object:
+	   case start_array:
+		  if (after == start + 1){
+			 after = endOfContainer(start);
+			 if (json_unlikely(after == 0)) fail();
+		  }
+		  break;
+	   default:
+		  break;
+    }
+}
+
+json_string JSONReader::unescape(void) const json_nothrow {
+    const json_char * const last = after - 1;
+    if (json_likely(!escaped)) return json_string(start + 1, last - start - 1);
+
+    json_string res;
+    const json_char * run = start + 1;
+    for(const json_char * p = run; p != last; ++p){
+	   if (*p == JSON_TEXT('\\')){
+		  res.append(run, p - run);
+		  if (*++p == JSON_TEXT('\"')){  //endOfString has already made sure this can't run off of the end
+			 res += JSON_TEXT('\"');
+		  } else {
+			 JSONWorker::SpecialChar(p, last, res);
+		  }
+		  run = p + 1;
+	   }
+    }
+    res.append(run, last - run);
+    return res;
+}
+
+json_string JSONReader::read_key(void) const json_nothrow {
+    JSON_ASSERT_SAFE(type == key, JSON_TEXT("read_key when the reader isn't on a key"), return json_global(EMPTY_JSON_STRING););
+    return unescape();
+}
+
+bool JSONReader::key_equals(const json_string & name) const json_nothrow {
+    if (type != key) return false;
+    if (json_unlikely(escaped)) return unescape() == name;
+    const size_t len = after - start - 2;
+    return (name.length() == len) && (std::memcmp(name.data(), start + 1, len * sizeof(json_char)) == 0);
+}
+
+json_string JSONReader::read_string(void) const json_nothrow {
+    JSON_ASSERT_SAFE(type == string, JSON_TEXT("read_string when the reader isn't on a string"), return json_global(EMPTY_JSON_STRING););
+    return unescape();
+}
+
+json_number JSONReader::read_number(void) const json_nothrow {
+    JSON_ASSERT_SAFE(type == number, JSON_TEXT("read_number when the reader isn't on a number"), return (json_number)0.0;);
+    return NumberToString::_atof(start, after - start);
+}
+
+bool JSONReader::read_bool(void) const json_nothrow {
+    JSON_ASSERT_SAFE(type == boolean, JSON_TEXT("read_bool when the reader isn't on a boolean"), return false;);
+    return LOWERCASE(*start) == JSON_TEXT('t');
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef LIBJSON_GUARD_READER_H
+#define LIBJSON_GUARD_READER_H
+
+#include "JSONDebug.h"
+#include "JSONMemory.h"
+#include "JSONGlobals.h"
+
+/*
+ *	A forward only cursor over raw JSON text.  Nothing is built or copied
+ *	until it is asked for: next() moves onto the next token and says what it
+ *	is, the read functions decode the token that the cursor is sitting on,
+ *	and skip_value() jumps over a whole object or array by only matching up
+ *	brackets.  This is for callers that want a handful of values out of a lot
+ *	of text, reading two members of every object in a big array never costs
+ *	more than a scan over the others.
+ *
+ *	    JSONReader reader(text, len);
+ *	    reader.next();  //start_array
+ *	    while (reader.next() == JSONReader::start_object){
+ *	       while (reader.next() == JSONReader::key){
+ *	          if (reader.key_equals(JSON_TEXT("id"))){
+ *	             reader.next();
+ *	             id = reader.read_number();
+ *	          } else {
+ *	             reader.skip_value();
+ *	          }
+ *	       }
+ *	    }
+ *
+ *	The text is not copied, so it must outlive the reader.  It may have white
+ *	space and, unless JSON_STRICT is defined, comments in it.  Anything that
+ *	doesn't fit the grammar makes next() return invalid from then on.
+ */
+
+#ifdef JSON_READ_PRIORITY
+
+class JSONReader {
+public:
+    enum token {
+	   end_of_input,	//the root value and everything after it has been read
+	   start_object,
+	   end_object,
+	   start_array,
+	   end_array,
+	   key,		  //a member name, the value is the next token
+	   string,
+	   number,
+	   boolean,
+	   null_value,
+	   invalid
+    };
+
+	LIBJSON_OBJECT(JSONReader);
+    JSONReader(const json_char * json, size_t len) json_nothrow;
+    explicit JSONReader(const json_char * json) json_nothrow;  //null terminated
+    explicit JSONReader(const json_string & json) json_nothrow;
+    ~JSONReader(void) json_nothrow;
+
+    token next(void) json_nothrow json_read_priority;
+    inline token current(void) const json_nothrow { return type; }
+    inline size_t depth(void) const json_nothrow { return stacksize; }
+
+    //on an object or array this jumps to its end, on a key it jumps past the member's value
+    void skip_value(void) json_nothrow json_read_priority;
+
+    json_string read_key(void) const json_nothrow json_read_priority;
+    bool key_equals(const json_string & name) const json_nothrow json_read_priority;
+    json_string read_string(void) const json_nothrow json_read_priority;
+    json_number read_number(void) const json_nothrow json_read_priority;
+    bool read_bool(void) const json_nothrow json_read_priority;
+
+    //the text of the current token, all of an object or array once it has been skipped
+    inline const json_char * raw(void) const json_nothrow { return start; }
+    inline size_t raw_length(void) const json_nothrow { return after - start; }
+JSON_PRIVATE
+    token value(const json_char * p) json_nothrow json_read_priority;
+    token fail(void) json_nothrow;
+    void push(json_char ch) json_nothrow;
+    const json_char * skipWhiteSpace(const json_char * p) const json_nothrow json_read_priority;
+    const json_char * endOfString(const json_char * p, bool & esc) const json_nothrow json_read_priority;
+    const json_char * endOfContainer(const json_char * p) const json_nothrow json_read_priority;
+    bool literal(const json_char * p, const json_char * word, size_t len) const json_nothrow json_read_priority;
+    json_string unescape(void) const json_nothrow json_read_priority;
+
+    const json_char * const end;
+    const json_char * start;	//first character of the current token
+    const json_char * after;	//first character after the current token
+    json_char * stack;	//the { and [ of the containers the cursor is in
+    size_t stacksize;
+    size_t stackcapacity;
+    token type;
+    bool escaped;	//the current string or key has a \ in it
+    bool begun;
+private:
+    JSONReader(const JSONReader &);
+    JSONReader & operator = (const JSONReader &);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef LIBJSON_GUARD_SAX_H
+#define LIBJSON_GUARD_SAX_H
+
+#include "JSONValidator.h"
+#include "JSONWorker.h"
+#include "NumberToString.h"
+
+/*
+ *	Walks the same grammar as JSONValidator, but tells a handler about
+ *	everything that it passes instead of only saying whether or not it was
+ *	valid, so that callers that only need a few values never build a tree.
+ *	It is templated on the handler so that the events can be inlined.  The
+ *	handler needs these, each one returns false to stop parsing:
+ *
+ *	   bool start_object(void);
+ *	   bool key(const json_char * name, size_t length);
+ *	   bool end_object(void);
+ *	   bool start_array(void);
+ *	   bool end_array(void);
+ *	   bool string(const json_char * value, size_t length);
+ *	   bool number(json_number value);
+ *	   bool boolean(bool value);
+ *	   bool null(void);
+ *
+ *	Names and strings are already unescaped, they only live until the event
+ *	returns.  The text must have had its white space and comments removed.
+ */
+
+#ifdef JSON_READ_PRIORITY
+
+#ifndef JSON_STRICT
+    #define SAX_LETTERCASE(x, y)\
+	   case JSON_TEXT(x):\
+	   case JSON_TEXT(y)
+    #define SAX_LETTERCHECK(x, y)\
+	   if (json_unlikely((*++ptr != JSON_TEXT(x)) && (*ptr != JSON_TEXT(y)))) return false
+#else
+    #define SAX_LETTERCASE(x, y)\
+	   case JSON_TEXT(x)
+    #define SAX_LETTERCHECK(x, y)\
+	   if (json_unlikely(*++ptr != JSON_TEXT(x))) return false
+#endif
+
+template<class Handler>
+class JSONSax {
+public:
+    JSONSax(Handler & handler_t) json_nothrow : handler(handler_t), scratch(){}
+
+    //json is stripped and null terminated, returns false if it was invalid or the handler stopped it
+    bool parse(const json_char * json) json_nothrow json_read_priority {
+	   const json_char * ptr = json;
+	   switch(*ptr){
+		  case JSON_TEXT('{'):
+			 if (json_likely(object(++ptr  DEPTH_ARG(1)))){
+				return *ptr == JSON_TEXT('\0');
+			 }
+			 return false;
+		  case JSON_TEXT('['):
+			 if (json_likely(array(++ptr  DEPTH_ARG(1)))){
+				return *ptr == JSON_TEXT('\0');
+			 }
+			 return false;
+	   }
+	   return false;
+    }
+JSON_PRIVATE
+    bool member(const json_char * & ptr  DEPTH_PARAM) json_nothrow json_read_priority {
+	   //ptr is on the first character of the member
+	   //ptr will end up immediately after the last character in the member
+	   switch(*ptr){
+		  case JSON_TEXT('\"'):
+			 return string(++ptr, false);
+		  case JSON_TEXT('{'):
+			 INC_DEPTH();
+			 return object(++ptr  DEPTH_ARG(depth_param));
+		  case JSON_TEXT('['):
+			 INC_DEPTH();
+			 return array(++ptr  DEPTH_ARG(depth_param));
+		  SAX_LETTERCASE('t', 'T'):
+			 SAX_LETTERCHECK('r', 'R');
+			 SAX_LETTERCHECK('u', 'U');
+			 SAX_LETTERCHECK('e', 'E');
+			 ++ptr;
+			 return handler.boolean(true);
+		  SAX_LETTERCASE('f', 'F'):
+			 SAX_LETTERCHECK('a', 'A');
+			 SAX_LETTERCHECK('l', 'L');
+			 SAX_LETTERCHECK('s', 'S');
+			 SAX_LETTERCHECK('e', 'E');
+			 ++ptr;
+			 return handler.boolean(false);
+		  SAX_LETTERCASE('n', 'N'):
+			 SAX_LETTERCHECK('u', 'U');
+			 SAX_LETTERCHECK('l', 'L');
+			 SAX_LETTERCHECK('l', 'L');
+			 ++ptr;
+			 return handler.null();
+		  #ifndef JSON_STRICT
+			 case JSON_TEXT('}'):  //null in libjson
+			 case JSON_TEXT(']'):  //null in libjson
+			 case JSON_TEXT(','):  //null in libjson
+				return handler.null();
+		  #endif
+		  case JSON_TEXT('\0'):
+			 return false;
+	   }
+	   //a number
+	   const json_char * start = ptr;
+	   if (json_unlikely(!JSONValidator::isValidNumber(ptr))) return false;
+	   return handler.number(NumberToString::_atof(start, ptr - start));
+    }
+
+    bool string(const json_char * & ptr, bool key) json_nothrow json_read_priority {
+	   //ptr is pointing to the first character after the quote
+	   //ptr will end up behind the closing "
+	   const json_char * start = ptr;
+	   if (json_unlikely(!JSONValidator::isValidString(ptr))) return false;
+	   const json_char * const end = ptr - 1;
+
+	   //most strings have nothing escaped, those go straight out of the text
+	   const json_char * p = start;
+	   while ((p != end) && (*p != JSON_TEXT('\\'))) ++p;
+	   if (json_likely(p == end)){
+		  return key ? handler.key(start, end - start) : handler.string(start, end - start);
+	   }
+
+	   scratch.assign(start, p - start);
+	   const json_char * run = p;
+	   for(; p != end; ++p){
+		  if (*p == JSON_TEXT('\\')){
+			 scratch.append(run, p - run);
+			 if (*++p == JSON_TEXT('\"')){  //the validator has already made sure this can't run off of the end
+				scratch += JSON_TEXT('\"');
+			 } else {
+				JSONWorker::SpecialChar(p, end, scratch);
+			 }
+			 run = p + 1;
+		  }
+	   }
+	   scratch.append(run, end - run);
+	   return key ? handler.key(scratch.data(), scratch.length()) : handler.string(scratch.data(), scratch.length());
+    }
+
+    bool object(const json_char * & ptr  DEPTH_PARAM) json_nothrow json_read_priority {
+	   //ptr should currently be pointing past the {, so this must be the start of a name, or the closing }
+	   //ptr will end up past the last }
+	   if (json_unlikely(!handler.start_object())) return false;
+	   if (*ptr == JSON_TEXT('}')){
+		  ++ptr;
+		  return handler.end_object();
+	   }
+	   while(true){
+		  if (json_unlikely(*ptr != JSON_TEXT('\"'))) return false;
+		  if (json_unlikely(!string(++ptr, true))) return false;
+		  if (json_unlikely(*ptr++ != JSON_TEXT(':'))) return false;
+		  if (json_unlikely(!member(ptr  DEPTH_ARG(depth_param)))) return false;
+		  switch(*ptr){
+			 case JSON_TEXT(','):
+				++ptr;
+				break;
+			 case JSON_TEXT('}'):
+				++ptr;
+				return handler.end_object();
+			 default:
+				return false;
+		  }
+	   }
+    }
+
+    bool array(const json_char * & ptr  DEPTH_PARAM) json_nothrow json_read_priority {
+	   //ptr should currently be pointing past the [, so this must be the start of a member, or the closing ]
+	   //ptr will end up past the last ]
+	   if (json_unlikely(!handler.start_array())) return false;
+	   if (*ptr == JSON_TEXT(']')){
+		  ++ptr;
+		  return handler.end_array();
+	   }
+	   while(true){
+		  if (json_unlikely(!member(ptr  DEPTH_ARG(depth_param)))) return false;
+		  switch(*ptr){
+			 case JSON_TEXT(','):
+				++ptr;
+				break;
+			 case JSON_TEXT(']'):
+				++ptr;
+				return handler.end_array();
+			 default:
+				return false;
+		  }
+	   }
+    }
+
+    Handler & handler;
+    json_string scratch;  //where escaped strings are put back together, reused so it only allocates once
+private:
+    JSONSax(const JSONSax &);
+    JSONSax & operator = (const JSONSax &);
+};
+
+#undef SAX_LETTERCASE
+#undef SAX_LETTERCHECK
+
+#endif
+
+#endif
@@ -8,7 +8,14 @@
  *	can be infered by an offset and length and a pointer to the master
  *	string
  *
- *	EXPERIMENTAL, Not used yet
+ *	Unfetched nodes keep their text in one of these, so that all of the
+ *	children of a document point into the same buffer instead of each
+ *	level of the tree copying its part of it.  An empty one doesn't
+ *	allocate anything.
+ *
+ *	It can also borrow a buffer that belongs to somebody else, which is how
+ *	in situ parsing works.  Nothing is copied out of a borrowed buffer until
+ *	something asks for a real json_string.
  */
 
 #include "JSONDebug.h"
@@ -164,6 +171,7 @@ public:
 	
 
 	inline json_string::iterator std_begin(void){
+		if (json_unlikely((_str == 0) || (_str -> borrowed != 0))) return toString().begin();
 		return _str -> mystring.begin() + offset;
 	}
 	inline json_string::iterator std_end(void){
@@ -171,26 +179,35 @@ public:
 	}
 	
 	inline json_string::const_iterator std_begin(void) const{
+		if (json_unlikely(_str == 0)) return json_global(EMPTY_JSON_STRING).begin();
+		if (json_unlikely(_str -> borrowed != 0)) toString();
 		return _str -> mystring.begin() + offset;
 	}
 	inline json_string::const_iterator std_end(void) const{
 		return std_begin() + len;
 	}
 	
-	inline json_shared_string(void) : offset(0), len(0), _str(new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(json_global(EMPTY_JSON_STRING))) {}
+	inline json_shared_string(void) : _str(0), offset(0), len(0) {}
+	
+	inline json_shared_string(const json_string & str) : _str(new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(str)), offset(0), len(str.length()) {}
+	
+	inline json_shared_string(const json_char * str, size_t _len) : _str(new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(str, _len)), offset(0), len(_len) {}
 	
-	inline json_shared_string(const json_string & str) : offset(0), len(str.length()), _str(new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(str)) {}
+	//points at text that somebody else owns and keeps alive for as long as this is around
+	static inline json_shared_string borrow(json_char * str, size_t _len){
+		return json_shared_string(new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(str), _len);
+	}
 	
 	inline json_shared_string(const json_shared_string & str, size_t _offset, size_t _len) : _str(str._str), offset(str.offset + _offset), len(_len) {
-		++_str -> refCount;
+		ref();
 	}
 	
 	inline json_shared_string(const json_shared_string & str, size_t _offset) : _str(str._str), offset(str.offset + _offset), len(str.len - _offset) {
-		++_str -> refCount;
+		ref();
 	}
 	
-	inline json_shared_string(const iterator & s, const iterator & e) : _str(s.parent -> _str), offset(s.it - s.parent -> _str -> mystring.data()), len(e.it - s.it){
-		++_str -> refCount;
+	inline json_shared_string(const iterator & s, const iterator & e) : _str(s.parent -> _str), offset(s.it - s.parent -> _str -> base()), len(e.it - s.it){
+		ref();
 	}
 	
 	inline ~json_shared_string(void){
@@ -200,24 +217,35 @@ public:
 	inline bool empty(void) const { return len == 0; }
 	
 	size_t find(json_char ch, size_t pos = 0) const {
-		if (_str -> refCount == 1) return _str -> mystring.find(ch, pos);
-		json_string::const_iterator e = std_end();
-		for(json_string::const_iterator b = std_begin() + pos; b != e; ++b){
-			if (*b == ch) return b - std_begin();
+		if (_str == 0) return json_string::npos;
+		if ((_str -> refCount == 1) && (offset == 0) && (len == _str -> mystring.length())) return _str -> mystring.find(ch, pos);
+		const json_char * const b = data();
+		for(size_t i = pos; i < len; ++i){
+			if (b[i] == ch) return i;
 		}
 		return json_string::npos;
 	}
 	
 	inline json_char & operator[] (size_t loc){
+		if (json_unlikely(_str -> borrowed != 0)) return _str -> borrowed[loc + offset];
 		return _str -> mystring[loc + offset];
 	}
 	inline json_char operator[] (size_t loc) const {
-		return _str -> mystring[loc + offset];
+		return data()[loc];
+	}
+	//lets go of the master string entirely
+	inline void clear(){
+		deref();
+		_str = 0;
+		offset = 0;
+		len = 0;
 	}
-	inline void clear(){ len = 0; }
 	inline size_t length() const { return len; }
 	inline const json_char * c_str() const { return toString().c_str(); }
-	inline const json_char * data() const { return _str -> mystring.data() + offset; }
+	inline const json_char * data() const {
+		if (json_unlikely(_str == 0)) return json_global(EMPTY_JSON_STRING).data();
+		return _str -> base() + offset;
+	}
 	
 	inline bool operator != (const json_shared_string & other) const {
 		if ((other._str == _str) && (other.len == len) && (other.offset == offset)) return false;
@@ -229,13 +257,20 @@ public:
 		return other.toString() == toString();
 	}
 	
+	//compares in place, without making its own copy of the substring
 	inline bool operator == (const json_string & other) const {
-		return other == toString();
+		return (other.length() == len) && (std::memcmp(other.data(), data(), len * sizeof(json_char)) == 0);
 	}
 	
 	json_string & toString(void) const {
 		//gonna have to do a real substring now anyway, so do it completely
-		if (_str -> refCount == 1){
+		if (json_unlikely(_str == 0)){
+			_str = new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(json_global(EMPTY_JSON_STRING));
+		} else if (json_unlikely(_str -> borrowed != 0)){
+			json_shared_string_internal * copy = new(json_malloc<json_shared_string_internal>(1)) json_shared_string_internal(data(), len);
+			deref();
+			_str = copy;
+		} else if (_str -> refCount == 1){
 			if (offset || len != _str -> mystring.length()){
 				_str -> mystring = json_string(std_begin(), std_end());
 			}
@@ -252,21 +287,21 @@ public:
 		if (other._str != _str){
 			deref();
 			_str = other._str;
+			ref();
 		}
-		++_str -> refCount;
 		offset = other.offset + _offset;
 		len = _len;
 	}
 	
 	json_shared_string(const json_shared_string & other) : _str(other._str), offset(other.offset), len(other.len){
-		++_str -> refCount;
+		ref();
 	}
 	
 	json_shared_string & operator =(const json_shared_string & other){
 		if (other._str != _str){
 			deref();
 			_str = other._str;
-			++_str -> refCount;
+			ref();
 		}
 		offset = other.offset;
 		len = other.len;
@@ -282,12 +317,22 @@ public:
 	//when doing a plus equal of another string, see if it shares the string and starts where this one left off, in which case just increase len
 JSON_PRIVATE
 	struct json_shared_string_internal {
-		inline json_shared_string_internal(const json_string & _mystring) : mystring(_mystring), refCount(1) {}
+		inline json_shared_string_internal(const json_string & _mystring) : mystring(_mystring), refCount(1), borrowed(0) {}
+		inline json_shared_string_internal(const json_char * _mystring, size_t _len) : mystring(_mystring, _len), refCount(1), borrowed(0) {}
+		inline json_shared_string_internal(json_char * _borrowed) : mystring(), refCount(1), borrowed(_borrowed) {}
+		inline const json_char * base(void) const {
+			return json_unlikely(borrowed != 0) ? borrowed : mystring.data();
+		}
 		json_string mystring;
 		size_t refCount PACKED(20);
+		json_char * borrowed;  //somebody else's buffer, mystring isn't used when this is set
 	};
-	inline void deref(void){
-		if (--_str -> refCount == 0){
+	inline json_shared_string(json_shared_string_internal * internal, size_t _len) : _str(internal), offset(0), len(_len) {}
+	inline void ref(void) const {
+		if (json_likely(_str != 0)) ++_str -> refCount;
+	}
+	inline void deref(void) const {
+		if (json_likely(_str != 0) && (--_str -> refCount == 0)){
 			_str -> ~json_shared_string_internal();
 			libjson_free<json_shared_string_internal>(_str);
 		}
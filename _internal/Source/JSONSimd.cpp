@@ -0,0 +1,480 @@
+#include "JSONSimd.h"
+#include "JSONUtf8.h"
+
+#ifdef JSON_SIMD
+
+#include <cstring>
+#include <emmintrin.h>
+#ifdef JSON_SIMD_AVX2
+    #include <immintrin.h>
+    #define JSON_AVX2_FUNCTION __attribute__((target("avx2,popcnt")))
+#endif
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+/*
+ *	The kernels write a full block to runner even when they only keep part of
+ *	it.  That is safe because they are only used while writing into a buffer
+ *	that is as large as the text, and runner is never ahead of p, as nothing
+ *	before the kernels ever grows the text.  The one exception is stripping in
+ *	place, where the spare part of the block could land on characters that
+ *	haven't been looked at yet, so when runner is that close behind p, only
+ *	the characters that are being kept get written.
+ */
+
+static inline unsigned int lowestBit(unsigned int mask) json_nothrow {
+    JSON_ASSERT(mask != 0, JSON_TEXT("lowestBit of nothing"));
+    #ifdef _MSC_VER
+	   unsigned long res;
+	   _BitScanForward(&res, mask);
+	   return (unsigned int)res;
+    #else
+	   return (unsigned int)__builtin_ctz(mask);
+    #endif
+}
+
+//copies the characters whose bits are set, for blocks that are sprinkled with white space
+static inline void keepBits(const json_char * p, unsigned int keep, json_char * & runner) json_nothrow {
+    while (keep){
+	   *runner++ = p[lowestBit(keep)];
+	   keep &= keep - 1;
+    }
+}
+
+//whether a block stored at runner would reach past p, only possible when runner and p are in the same buffer
+static inline bool overlaps(const json_char * p, const json_char * runner, size_t block) json_nothrow {
+    return ((size_t)p - (size_t)runner) < block;
+}
+
+//the bits that come before the lowest one that is set, or all of them if there isn't one
+#define BITS_BEFORE(mask, all) ((mask) ? (((mask) & (0u - (mask))) - 1) : (all))
+
+#define SSE2_BLOCK 16
+#define SSE2_ALL 0xFFFFu
+
+static inline unsigned int whiteSpaceSSE2(__m128i v) json_nothrow {
+    return (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+									  _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')))));
+}
+
+//quotes, comments and anything that isn't printable ascii, the signed compare catches everything above 127 too
+static inline unsigned int stoppersSSE2(__m128i v) json_nothrow {
+    return (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('/'))),
+									  _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('#')), _mm_cmpeq_epi8(v, _mm_set1_epi8(127))),
+												_mm_cmplt_epi8(v, _mm_set1_epi8(32)))));
+}
+
+static void copyStringSSE2(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+    while (end - p >= SSE2_BLOCK){
+	   const __m128i v = _mm_loadu_si128((const __m128i *)p);
+	   const unsigned int stop = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+	   if (stop){
+		  if (json_unlikely(overlaps(p, runner, SSE2_BLOCK))){
+			 std::memmove(runner, p, lowestBit(stop) * sizeof(json_char));
+		  } else {
+			 _mm_storeu_si128((__m128i *)runner, v);
+		  }
+		  p += lowestBit(stop);
+		  runner += lowestBit(stop);
+		  return;
+	   }
+	   _mm_storeu_si128((__m128i *)runner, v);
+	   p += SSE2_BLOCK;
+	   runner += SSE2_BLOCK;
+    }
+}
+
+static const json_char * findEscapeSSE2(const json_char * p, const json_char * const end) json_nothrow {
+    while (end - p >= SSE2_BLOCK){
+	   const unsigned int found = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), _mm_set1_epi8('\\')));
+	   if (found) return p + lowestBit(found);
+	   p += SSE2_BLOCK;
+    }
+    while ((p != end) && (*p != '\\')) ++p;
+    return p;
+}
+
+/*
+   Quotes and backslashes, and with JSON_ESCAPE_WRITES also forward slashes,
+   control characters and everything past 126 that isn't UTF-8, the same as
+   the writer's table
+*/
+#ifdef JSON_UTF8
+    #define JSON_UNSAFE_TOP 127
+#else
+    #define JSON_UNSAFE_TOP 255
+#endif
+
+static inline bool unsafe(json_char ch) json_nothrow {
+    #ifdef JSON_ESCAPE_WRITES
+	   return (ch == '\"') || (ch == '\\') || (ch == '/') || ((unsigned char)ch < 32) || (((unsigned char)ch > 126) && ((unsigned char)ch <= JSON_UNSAFE_TOP));
+    #else
+	   return (ch == '\"') || (ch == '\\');
+    #endif
+}
+
+static inline unsigned int unsafeSSE2(__m128i v) json_nothrow {
+    const __m128i res = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    #if defined(JSON_ESCAPE_WRITES) && defined(JSON_UTF8)  //only bytes whose top three bits are clear are control characters
+	   return (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(res, _mm_cmpeq_epi8(v, _mm_set1_epi8('/'))),
+										   _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(127)), _mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char)0xE0)), _mm_setzero_si128()))));
+    #elif defined(JSON_ESCAPE_WRITES)  //the signed compare catches everything above 127 too
+	   return (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(res, _mm_cmpeq_epi8(v, _mm_set1_epi8('/'))),
+										   _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(127)), _mm_cmplt_epi8(v, _mm_set1_epi8(32)))));
+    #else
+	   return (unsigned int)_mm_movemask_epi8(res);
+    #endif
+}
+
+static const json_char * findUnsafeSSE2(const json_char * p, const json_char * const end) json_nothrow {
+    while (end - p >= SSE2_BLOCK){
+	   const unsigned int found = unsafeSSE2(_mm_loadu_si128((const __m128i *)p));
+	   if (found) return p + lowestBit(found);
+	   p += SSE2_BLOCK;
+    }
+    while ((p != end) && !unsafe(*p)) ++p;
+    return p;
+}
+
+//there's no shuffle in SSE2, so without AVX2 it is checked the plain way
+static bool validUtf8SSE2(const json_char * p, const json_char * const end) json_nothrow {
+    return JSONUtf8::scan(p, end - p);
+}
+
+static void removeWhiteSpaceSSE2(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+    while (end - p >= SSE2_BLOCK){
+	   const __m128i v = _mm_loadu_si128((const __m128i *)p);
+	   const unsigned int white = whiteSpaceSSE2(v);
+	   const unsigned int stop = stoppersSSE2(v) & ~white;
+	   const unsigned int wanted = BITS_BEFORE(stop, SSE2_ALL);
+	   if (stop){
+		  if (((white & wanted) == 0) && !overlaps(p, runner, SSE2_BLOCK)){
+			 _mm_storeu_si128((__m128i *)runner, v);
+			 runner += lowestBit(stop);
+		  } else {
+			 keepBits(p, wanted & ~white, runner);
+		  }
+		  p += lowestBit(stop);
+		  return;
+	   }
+	   if (white == 0){
+		  _mm_storeu_si128((__m128i *)runner, v);
+		  runner += SSE2_BLOCK;
+	   } else {
+		  keepBits(p, ~white & SSE2_ALL, runner);
+	   }
+	   p += SSE2_BLOCK;
+    }
+}
+
+#ifdef JSON_SIMD_AVX2
+    #define AVX2_BLOCK 32
+    #define AVX2_ALL 0xFFFFFFFFu
+
+    /*
+	   For every combination of 8 characters to keep, the shuffle that packs
+	   them to the front.  It is filled in by resolve, before AVX2 is chosen
+    */
+    static unsigned char packTable[256][8];
+
+    static void fillPackTable(void) json_nothrow {
+	   for(unsigned int keep = 0; keep < 256; ++keep){
+		  unsigned int count = 0;
+		  for(unsigned int i = 0; i < 8; ++i){
+			 if (keep & (1u << i)) packTable[keep][count++] = (unsigned char)i;
+		  }
+		  while (count < 8) packTable[keep][count++] = 0x80;  //zeroes, they get overwritten anyway
+	   }
+    }
+
+    //keepBits, but 8 characters at a time
+    JSON_AVX2_FUNCTION static inline void packBitsAVX2(const json_char * p, unsigned int keep, json_char * & runner) json_nothrow {
+	   for(unsigned int i = 0; i < AVX2_BLOCK; i += 8, keep >>= 8){
+		  const unsigned int quarter = keep & 0xFF;
+		  const __m128i packed = _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)(p + i)), _mm_loadl_epi64((const __m128i *)packTable[quarter]));
+		  _mm_storel_epi64((__m128i *)runner, packed);
+		  runner += __builtin_popcount(quarter);
+	   }
+    }
+
+    JSON_AVX2_FUNCTION static inline unsigned int whiteSpaceAVX2(__m256i v) json_nothrow {
+	   return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+												_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')))));
+    }
+
+    JSON_AVX2_FUNCTION static inline unsigned int stoppersAVX2(__m256i v) json_nothrow {
+	   return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'))),
+												_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('#')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(127))),
+															 _mm256_cmpgt_epi8(_mm256_set1_epi8(32), v))));
+    }
+
+    JSON_AVX2_FUNCTION static void copyStringAVX2(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+	   while (end - p >= AVX2_BLOCK){
+		  const __m256i v = _mm256_loadu_si256((const __m256i *)p);
+		  const unsigned int stop = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))));
+		  if (stop){
+			 if (json_unlikely(overlaps(p, runner, AVX2_BLOCK))){
+				std::memmove(runner, p, lowestBit(stop) * sizeof(json_char));
+			 } else {
+				_mm256_storeu_si256((__m256i *)runner, v);
+			 }
+			 p += lowestBit(stop);
+			 runner += lowestBit(stop);
+			 return;
+		  }
+		  _mm256_storeu_si256((__m256i *)runner, v);
+		  p += AVX2_BLOCK;
+		  runner += AVX2_BLOCK;
+	   }
+	   copyStringSSE2(p, end, runner);
+    }
+
+    JSON_AVX2_FUNCTION static const json_char * findEscapeAVX2(const json_char * p, const json_char * const end) json_nothrow {
+	   while (end - p >= AVX2_BLOCK){
+		  const unsigned int found = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), _mm256_set1_epi8('\\')));
+		  if (found) return p + lowestBit(found);
+		  p += AVX2_BLOCK;
+	   }
+	   return findEscapeSSE2(p, end);
+    }
+
+    JSON_AVX2_FUNCTION static inline unsigned int unsafeAVX2(__m256i v) json_nothrow {
+	   const __m256i res = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+	   #if defined(JSON_ESCAPE_WRITES) && defined(JSON_UTF8)
+		  return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(res, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'))),
+												 _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(127)), _mm256_cmpeq_epi8(_mm256_and_si256(v, _mm256_set1_epi8((char)0xE0)), _mm256_setzero_si256()))));
+	   #elif defined(JSON_ESCAPE_WRITES)
+		  return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(res, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'))),
+												 _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(127)), _mm256_cmpgt_epi8(_mm256_set1_epi8(32), v))));
+	   #else
+		  return (unsigned int)_mm256_movemask_epi8(res);
+	   #endif
+    }
+
+    JSON_AVX2_FUNCTION static const json_char * findUnsafeAVX2(const json_char * p, const json_char * const end) json_nothrow {
+	   while (end - p >= AVX2_BLOCK){
+		  const unsigned int found = unsafeAVX2(_mm256_loadu_si256((const __m256i *)p));
+		  if (found) return p + lowestBit(found);
+		  p += AVX2_BLOCK;
+	   }
+	   return findUnsafeSSE2(p, end);
+    }
+
+    JSON_AVX2_FUNCTION static void removeWhiteSpaceAVX2(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+	   while (end - p >= AVX2_BLOCK){
+		  const __m256i v = _mm256_loadu_si256((const __m256i *)p);
+		  const unsigned int white = whiteSpaceAVX2(v);
+		  const unsigned int stop = stoppersAVX2(v) & ~white;
+		  const unsigned int wanted = BITS_BEFORE(stop, AVX2_ALL);
+		  if (stop){
+			 if (json_unlikely(overlaps(p, runner, AVX2_BLOCK))){
+			    keepBits(p, wanted & ~white, runner);
+			 } else if ((white & wanted) == 0){
+			    _mm256_storeu_si256((__m256i *)runner, v);
+			    runner += lowestBit(stop);
+			 } else {
+			    packBitsAVX2(p, wanted & ~white, runner);
+			 }
+			 p += lowestBit(stop);
+			 return;
+		  }
+		  if (white == 0){
+			 _mm256_storeu_si256((__m256i *)runner, v);
+			 runner += AVX2_BLOCK;
+		  } else {
+			 packBitsAVX2(p, ~white, runner);
+		  }
+		  p += AVX2_BLOCK;
+	   }
+	   removeWhiteSpaceSSE2(p, end, runner);  //the last few characters might still fill a smaller block
+    }
+
+    /*
+	   UTF-8 is checked with Keiser and Lemire's lookup tables.  Every byte is
+	   looked at together with the one before it: the high nibble of that one,
+	   its low nibble and the high nibble of this one each look up a byte of
+	   error bits that the pair could be, and only a pair that is really wrong
+	   has a bit set in all three.  The only thing that pairs can't see is a
+	   continuation byte that is the third or fourth of a sequence, which is
+	   found from the bytes two and three back instead.
+    */
+    #define TOO_SHORT (1 << 0)  //a lead byte, or ascii, where a continuation should be
+    #define TOO_LONG (1 << 1)  //a continuation after ascii
+    #define OVERLONG_3 (1 << 2)
+    #define TOO_LARGE (1 << 3)  //past U+10FFFF
+    #define SURROGATE (1 << 4)
+    #define OVERLONG_2 (1 << 5)
+    #define TOO_LARGE_1000 (1 << 6)
+    #define OVERLONG_4 (1 << 6)
+    #define TWO_CONTS (1 << 7)  //a continuation after a continuation, fine if it is the third or fourth byte
+    #define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)  //the ones that don't depend on the low nibble
+
+    //a 16 byte table in both halves, which is what the shuffle looks things up in
+    #define NIBBLE_TABLE(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)\
+	   _mm256_setr_epi8((char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h),\
+					(char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p),\
+					(char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h),\
+					(char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p))
+
+    //the block shifted along by n bytes, with the end of the previous block coming in at the front
+    #define BYTES_BEFORE(v, previous, n) _mm256_alignr_epi8(v, _mm256_permute2x128_si256(previous, v, 0x21), 16 - (n))
+
+    JSON_AVX2_FUNCTION static inline __m256i highNibblesAVX2(__m256i v) json_nothrow {
+	   return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    JSON_AVX2_FUNCTION static inline __m256i utf8ErrorsAVX2(__m256i v, __m256i previous) json_nothrow {
+	   const __m256i before = BYTES_BEFORE(v, previous, 1);
+	   const __m256i firstHigh = _mm256_shuffle_epi8(NIBBLE_TABLE(
+		  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,  //ascii
+		  TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,  //continuations
+		  TOO_SHORT | OVERLONG_2,  //C0 to CF
+		  TOO_SHORT,  //D0 to DF
+		  TOO_SHORT | OVERLONG_3 | SURROGATE,  //E0 to EF
+		  TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4), highNibblesAVX2(before));  //F0 to FF
+	   const __m256i firstLow = _mm256_shuffle_epi8(NIBBLE_TABLE(
+		  CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,  //C0, E0, F0
+		  CARRY | OVERLONG_2,  //C1
+		  CARRY,
+		  CARRY,
+		  CARRY | TOO_LARGE,  //F4
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,  //ED
+		  CARRY | TOO_LARGE | TOO_LARGE_1000,
+		  CARRY | TOO_LARGE | TOO_LARGE_1000), _mm256_and_si256(before, _mm256_set1_epi8(0x0F)));
+	   const __m256i secondHigh = _mm256_shuffle_epi8(NIBBLE_TABLE(
+		  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,  //ascii
+		  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,  //80 to 8F
+		  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,  //90 to 9F
+		  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,  //A0 to BF
+		  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT), highNibblesAVX2(v));  //lead bytes
+	   const __m256i pairs = _mm256_and_si256(_mm256_and_si256(firstHigh, firstLow), secondHigh);
+
+	   //the top bit is set where a three or four byte sequence says that this has to be a continuation
+	   const __m256i third = _mm256_subs_epu8(BYTES_BEFORE(v, previous, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+	   const __m256i fourth = _mm256_subs_epu8(BYTES_BEFORE(v, previous, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+	   const __m256i continuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+	   return _mm256_xor_si256(continuation, pairs);
+    }
+
+    //anything but zero if the block ends in the middle of a sequence
+    JSON_AVX2_FUNCTION static inline __m256i unfinishedAVX2(__m256i v) json_nothrow {
+	   return _mm256_subs_epu8(v, _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+										   -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1)));
+    }
+
+    JSON_AVX2_FUNCTION static bool validUtf8AVX2(const json_char * p, const json_char * const end) json_nothrow {
+	   __m256i previous = _mm256_setzero_si256();
+	   __m256i errors = _mm256_setzero_si256();
+	   __m256i unfinished = _mm256_setzero_si256();
+	   json_char last[AVX2_BLOCK];
+	   while (p != end){
+		  __m256i v;
+		  if (end - p >= AVX2_BLOCK){
+			 v = _mm256_loadu_si256((const __m256i *)p);
+			 p += AVX2_BLOCK;
+		  } else {  //the last few are padded out with nulls, which are ascii and so change nothing
+			 std::memset(last, 0, sizeof(last));
+			 std::memcpy(last, p, (end - p) * sizeof(json_char));
+			 v = _mm256_loadu_si256((const __m256i *)last);
+			 p = end;
+		  }
+		  if (_mm256_movemask_epi8(v) == 0){  //all ascii, so only the end of the last block can be wrong
+			 errors = _mm256_or_si256(errors, unfinished);
+			 unfinished = _mm256_setzero_si256();
+		  } else {
+			 errors = _mm256_or_si256(errors, utf8ErrorsAVX2(v, previous));
+			 unfinished = unfinishedAVX2(v);
+		  }
+		  previous = v;
+	   }
+	   errors = _mm256_or_si256(errors, unfinished);
+	   return _mm256_testz_si256(errors, errors) != 0;
+    }
+
+    #undef TOO_SHORT
+    #undef TOO_LONG
+    #undef OVERLONG_3
+    #undef TOO_LARGE
+    #undef SURROGATE
+    #undef OVERLONG_2
+    #undef TOO_LARGE_1000
+    #undef OVERLONG_4
+    #undef TWO_CONTS
+    #undef CARRY
+    #undef NIBBLE_TABLE
+    #undef BYTES_BEFORE
+
+
+#endif
+
+//Everything starts out pointing at the resolvers, which swap in the real kernels the first time through
+JSONSimd::kernel_t JSONSimd::removeWhiteSpace = JSONSimd::resolveRemoveWhiteSpace;
+JSONSimd::kernel_t JSONSimd::copyString = JSONSimd::resolveCopyString;
+JSONSimd::finder_t JSONSimd::findEscape = JSONSimd::resolveFindEscape;
+JSONSimd::finder_t JSONSimd::findUnsafe = JSONSimd::resolveFindUnsafe;
+JSONSimd::checker_t JSONSimd::validUtf8 = JSONSimd::resolveValidUtf8;
+const char * JSONSimd::levelname = 0;
+
+void JSONSimd::resolve(void) json_nothrow {
+    #ifdef JSON_SIMD_AVX2
+	   __builtin_cpu_init();  //might be called before the constructors that normally do this
+	   if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")){
+		  fillPackTable();
+		  removeWhiteSpace = removeWhiteSpaceAVX2;
+		  copyString = copyStringAVX2;
+		  findEscape = findEscapeAVX2;
+		  findUnsafe = findUnsafeAVX2;
+		  validUtf8 = validUtf8AVX2;
+		  levelname = "avx2";
+		  return;
+	   }
+    #endif
+    removeWhiteSpace = removeWhiteSpaceSSE2;
+    copyString = copyStringSSE2;
+    findEscape = findEscapeSSE2;
+    findUnsafe = findUnsafeSSE2;
+    validUtf8 = validUtf8SSE2;
+    levelname = "sse2";
+}
+
+void JSONSimd::resolveRemoveWhiteSpace(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+    resolve();
+    removeWhiteSpace(p, end, runner);
+}
+
+void JSONSimd::resolveCopyString(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+    resolve();
+    copyString(p, end, runner);
+}
+
+const json_char * JSONSimd::resolveFindEscape(const json_char * p, const json_char * const end) json_nothrow {
+    resolve();
+    return findEscape(p, end);
+}
+
+const json_char * JSONSimd::resolveFindUnsafe(const json_char * p, const json_char * const end) json_nothrow {
+    resolve();
+    return findUnsafe(p, end);
+}
+
+bool JSONSimd::resolveValidUtf8(const json_char * p, const json_char * const end) json_nothrow {
+    resolve();
+    return validUtf8(p, end);
+}
+
+const char * JSONSimd::level(void) json_nothrow {
+    if (levelname == 0) resolve();
+    return levelname;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef JSON_SIMD_H
+#define JSON_SIMD_H
+
+#include "JSONDebug.h"
+
+/*
+ *	Kernels that look at a whole block of characters at once instead of
+ *	going through a switch one character at a time.  They only ever do the
+ *	easy part of the work, bulk copying characters that need nothing done
+ *	to them, and stop in front of anything interesting so that the normal
+ *	code can deal with it.  That way the output is exactly the same as if
+ *	they weren't there at all.  The exception is the UTF-8 check, which is
+ *	done entirely with lookup tables when AVX2 is there.
+ *
+ *	The widest instruction set that the processor supports is picked the
+ *	first time that a kernel is used.  They only work on narrow characters,
+ *	and can be turned off with JSON_NO_SIMD.
+ */
+
+#if !defined(JSON_NO_SIMD) && !defined(JSON_UNICODE)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	   #define JSON_SIMD
+	   #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		  #define JSON_SIMD_AVX2
+	   #endif
+    #endif
+#endif
+
+#ifdef JSON_SIMD
+
+class JSONSimd {
+public:
+    /*
+	   Copies everything outside of a string up to the next quote, comment or
+	   control character, dropping white space along the way.  p is left on the
+	   character that stopped it, or somewhere in the last block if nothing did
+    */
+    static inline void RemoveWhiteSpace(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+	   removeWhiteSpace(p, end, runner);
+    }
+
+    /*
+	   Copies the inside of a string up to the next quote or backslash, p is left
+	   on the character that stopped it, or somewhere in the last block if nothing did
+    */
+    static inline void CopyString(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow {
+	   copyString(p, end, runner);
+    }
+
+    //the first backslash from p on, or end if there isn't one, this one does look at every character
+    static inline const json_char * FindEscape(const json_char * p, const json_char * const end) json_nothrow {
+	   return findEscape(p, end);
+    }
+
+    //the first character from p on that has to be escaped when it's written, or end if there isn't one
+    static inline const json_char * FindUnsafe(const json_char * p, const json_char * const end) json_nothrow {
+	   return findUnsafe(p, end);
+    }
+
+    //whether the text is well formed UTF-8, see JSONUtf8
+    static inline bool ValidUtf8(const json_char * p, const json_char * const end) json_nothrow {
+	   return validUtf8(p, end);
+    }
+
+    //the name of the instruction set being used, mostly for tests
+    static const char * level(void) json_nothrow;
+
+JSON_PRIVATE
+    typedef void (*kernel_t)(const json_char * &, const json_char * const, json_char * &);
+    static kernel_t removeWhiteSpace;
+    static kernel_t copyString;
+    typedef const json_char * (*finder_t)(const json_char *, const json_char * const);
+    static finder_t findEscape;
+    static finder_t findUnsafe;
+    typedef bool (*checker_t)(const json_char *, const json_char * const);
+    static checker_t validUtf8;
+    static const char * levelname;
+    static void resolve(void) json_nothrow;
+    static void resolveRemoveWhiteSpace(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow;
+    static void resolveCopyString(const json_char * & p, const json_char * const end, json_char * & runner) json_nothrow;
+    static const json_char * resolveFindEscape(const json_char * p, const json_char * const end) json_nothrow;
+    static const json_char * resolveFindUnsafe(const json_char * p, const json_char * const end) json_nothrow;
+    static bool resolveValidUtf8(const json_char * p, const json_char * const end) json_nothrow;
+private:
+    JSONSimd(void);
+};
+
+#endif
+
+#endif
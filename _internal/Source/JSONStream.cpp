@@ -3,13 +3,25 @@
 #ifdef JSON_STREAM
 #include "JSONWorker.h"
 #include "JSONValidator.h"
+#include "JSONThreads.h"
+#ifdef JSON_UTF8
+	#include "JSONUtf8.h"
+#endif
 
 
-JSONStream::JSONStream(json_stream_callback_t call_p, json_stream_e_callback_t call_e, void * callbackIdentifier) json_nothrow : state(true), call(call_p), err_call(call_e), buffer(), callback_identifier(callbackIdentifier) {
+JSONStream::JSONStream(json_stream_callback_t call_p, json_stream_e_callback_t call_e, void * callbackIdentifier, bool lines_p) json_nothrow : state(true), lines(lines_p), elements(false), ordered(true), call(call_p), err_call(call_e), batch_call(0), buffer(), callback_identifier(callbackIdentifier), threads(1), in_flight(0), path(), want(), tokens(0), want_index(0), key(0) {
 	LIBJSON_CTOR;
+	rewind();
 }
 
-JSONStream::JSONStream(const JSONStream & orig) json_nothrow : state(orig.state), call(orig.call), err_call(orig.err_call), buffer(orig.buffer), callback_identifier(orig.callback_identifier){
+JSONStream::JSONStream(const JSONStream & orig) json_nothrow : state(orig.state), lines(orig.lines), elements(orig.elements), ordered(orig.ordered), call(orig.call), err_call(orig.err_call), batch_call(orig.batch_call), buffer(orig.buffer), callback_identifier(orig.callback_identifier), threads(orig.threads), in_flight(orig.in_flight),
+	scanned(orig.scanned), start(orig.start), depth(orig.depth),
+	#ifdef JSON_SAFE
+		checked(orig.checked),
+	#endif
+	path(orig.path), want(orig.want), tokens(orig.tokens), matched(orig.matched), index(orig.index), want_index(orig.want_index), element(orig.element), key(orig.key),
+	in_key(orig.in_key), in_object(orig.in_object), expect_key(orig.expect_key), hit(orig.hit), past(orig.past),
+	in_string(orig.in_string), escaped(orig.escaped){
 	LIBJSON_COPY_CTOR;
 }
 
@@ -17,119 +29,565 @@ JSONStream & JSONStream::operator =(const JSONStream & orig) json_nothrow {
 	LIBJSON_ASSIGNMENT;
 	err_call = orig.err_call;
     call = orig.call;
+	batch_call = orig.batch_call;
 	state = orig.state;
+	lines = orig.lines;
+	ordered = orig.ordered;
+	threads = orig.threads;
+	in_flight = orig.in_flight;
     buffer = orig.buffer;
 	callback_identifier = orig.callback_identifier;
+	scanned = orig.scanned;
+	start = orig.start;
+	depth = orig.depth;
+	#ifdef JSON_SAFE
+		checked = orig.checked;
+	#endif
+	path = orig.path;
+	want = orig.want;
+	tokens = orig.tokens;
+	matched = orig.matched;
+	index = orig.index;
+	want_index = orig.want_index;
+	element = orig.element;
+	key = orig.key;
+	elements = orig.elements;
+	in_key = orig.in_key;
+	in_object = orig.in_object;
+	expect_key = orig.expect_key;
+	hit = orig.hit;
+	past = orig.past;
+	in_string = orig.in_string;
+	escaped = orig.escaped;
     return *this;
 }
 
 JSONStream & JSONStream::operator << (const json_string & str) json_nothrow {
+	return append(str.data(), str.length());
+}
+
+JSONStream & JSONStream::append(const json_char * str, size_t len) json_nothrow {
 	if (state){
-		buffer += str;
-		parse();
+		buffer.append(str, len);
+		if (lines){
+			parseLines();
+		} else if (elements){
+			parseElements();
+		} else {
+			parse();
+		}
 	}
 	return *this;
 }
 
 
-#define QUOTECASE_STREAM()\
-    case JSON_TEXT('\"'):\
-	   while (*(++p) != JSON_TEXT('\"')){\
-		  if (json_unlikely(*p == JSON_TEXT('\0'))) return json_string::npos;\
-	   }\
-	   break;
-
-
-#define NULLCASE_STREAM()\
-    case JSON_TEXT('\0'):\
-	   return json_string::npos;\
-
-
-#define BRACKET_STREAM(left, right)\
-    case left: {\
-	   size_t brac = 1;\
-	   while (brac){\
-		  switch (*(++p)){\
-			 case right:\
-				--brac;\
-				break;\
-			 case left:\
-				++brac;\
-				break;\
-			 QUOTECASE_STREAM()\
-			 NULLCASE_STREAM()\
-		  }\
-	   }\
-	   break;}\
-    case right:\
-	   return json_string::npos;
-
-#if (JSON_READ_PRIORITY == JSON_PRIO_HIGH) && (!(defined(JSON_LESS_MEMORY)))
-	#define STREAM_FIND_NEXT_RELEVANT(ch, vt, po) FindNextRelevant<ch>(vt, po)
-	template<json_char ch>
-	size_t JSONStream::FindNextRelevant(const json_string & value_t, const size_t pos) json_nothrow {
-#else
-	#define STREAM_FIND_NEXT_RELEVANT(ch, vt, po) FindNextRelevant(ch, vt, po)
-	size_t JSONStream::FindNextRelevant(json_char ch, const json_string & value_t, const size_t pos) json_nothrow {
+/*
+	Records aren't turned into nodes as soon as they're found when there are
+	threads to do it, their spans are saved up and handed out to the threads
+	in_flight at a time.  The buffer isn't touched until the scan is done, so
+	the spans stay good, and every record is stripped and parsed in its own
+	part of it, so the threads never write to the same memory
+*/
+#ifdef JSON_THREADS
+	#define JSON_BAD_RECORD ((JSONNode *)-1)
+
+	struct json_stream_job {
+		JSONStream * stream;
+		json_char * data;
+		const size_t * spans;  //where each record starts and how long it is
+		JSONNode ** results;  //what each record came out as, for when the calling thread gives them out
+		JSONNode * records;
+		size_t count;
+		volatile size_t next;
+	};
+
+	void JSONStream::parseRecords(void * arg) json_nothrow {
+		json_stream_job * job = (json_stream_job *)arg;
+		for(size_t i = JSONThreads::fetchAdd(job -> next); i < job -> count; i = JSONThreads::fetchAdd(job -> next)){
+			bool bad = false;
+			JSONNode * node = job -> stream -> recordNode(job -> data + job -> spans[i << 1], job -> spans[(i << 1) + 1], bad);
+			#ifndef JSON_PREPARSE
+				if (node) node -> preparse();  //the whole point is for the parsing to happen here
+			#endif
+			if (job -> results){
+				job -> results[i] = bad ? JSON_BAD_RECORD : node;
+			} else {
+				job -> stream -> deliver(node, bad, *job -> records);  //never batched here, so this is never touched
+			}
+		}
+	}
 #endif
-    const json_char * start = value_t.c_str();
-    for (const json_char * p = start + pos; *p; ++p){
-	   if (json_unlikely(*p == ch)) return p - start;
-	   switch (*p){
-			 BRACKET_STREAM(JSON_TEXT('['), JSON_TEXT(']'))
-			 BRACKET_STREAM(JSON_TEXT('{'), JSON_TEXT('}'))
-			 QUOTECASE_STREAM()
-	   }
-    };
-    return json_string::npos;
+
+void JSONStream::set_parallel(unsigned int threads_p, bool ordered_p, size_t in_flight_p) json_nothrow {
+	#ifdef JSON_THREADS
+		if (threads_p == 0) threads_p = JSONThreads::hardware();
+	#else
+		threads_p = 1;  //there's nothing to run them on, everything is done on the calling thread
+	#endif
+	threads = threads_p;
+	ordered = ordered_p;
+	in_flight = (in_flight_p != 0) ? in_flight_p : (size_t)threads_p * 64;
 }
 
+void JSONStream::set_elements(const json_string & pointer) json_nothrow {
+	size_t count = 0;
+	json_string token;
+	for(size_t pos = 0; pos < pointer.length(); ++count){
+		if (json_unlikely(!JSONWorker::PointerToken(pointer, pos, token))){
+			JSON_FAIL(JSON_TEXT("Not a valid JSON pointer"));
+			return;
+		}
+	}
+	elements = true;
+	path = pointer;
+	tokens = count;
+	rewindPath();
+}
+
+JSONStream::pending_records::pending_records(const JSONStream & stream) json_nothrow : spans(), count(0), size(0) {
+	if (stream.threads > 1){
+		size = stream.in_flight;
+		spans.set(json_malloc<size_t>(size << 1));
+	}
+}
+
+//a record that's been found, which is either turned into a node now or saved for the threads
+inline void JSONStream::record(json_char * data, size_t pos, size_t len, pending_records & pending, JSONNode & records) json_nothrow {
+	if (pending.size){
+		pending.spans.ptr[pending.count << 1] = pos;
+		pending.spans.ptr[(pending.count << 1) + 1] = len;
+		if (++pending.count == pending.size) dispatch(data, pending, records);
+		return;
+	}
+	bool bad = false;
+	JSONNode * node = recordNode(data + pos, len, bad);
+	deliver(node, bad, records);
+}
+
+//everything that's been saved up is parsed on the threads, and given out in order afterwards if it has to be
+void JSONStream::dispatch(json_char * data, pending_records & pending, JSONNode & records) json_nothrow {
+	if (pending.count == 0) return;
+	#ifdef JSON_THREADS
+		json_stream_job job;
+		json_auto<JSONNode *> results;
+		job.stream = this;
+		job.data = data;
+		job.spans = pending.spans.ptr;
+		job.results = 0;
+		job.records = &records;
+		job.count = pending.count;
+		job.next = 0;
+		if (ordered || batch_call){
+			results.set(json_malloc<JSONNode *>(pending.count));
+			job.results = results.ptr;
+		}
+		JSONThreads::run((threads < pending.count) ? threads : (unsigned int)pending.count, parseRecords, &job);
+		if (job.results){
+			for(size_t i = 0; i < pending.count; ++i){
+				const bool bad = (results.ptr[i] == JSON_BAD_RECORD);
+				deliver(bad ? 0 : results.ptr[i], bad, records);
+			}
+		}
+	#else
+		(void)data;
+		(void)records;
+	#endif
+	pending.count = 0;
+}
+
+/*
+	Picks up the scan where the last chunk left it, so it doesn't matter how
+	the text is cut up, each character is only ever looked at once.  Outside
+	of an object everything up to the next bracket is skipped, inside of one
+	only brackets and strings matter, and strings only end at a quote that
+	isn't escaped.  Which kind of bracket closes what is left for the parser
+	to complain about.
+*/
 void JSONStream::parse(void) json_nothrow {
 	#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
 		size_t objects = 0;
 	#endif
-	for(;;){
-		size_t pos = buffer.find_first_of(JSON_TEXT("{["));
-		if (json_likely(pos != json_string::npos)){
-		   size_t end = (buffer[pos] == JSON_TEXT('[')) ? STREAM_FIND_NEXT_RELEVANT(JSON_TEXT(']'), buffer, pos + 1) : STREAM_FIND_NEXT_RELEVANT(JSON_TEXT('}'), buffer, pos + 1);
-		   if (end != json_string::npos){
-			  #ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
-			     if (++objects > JSON_SECURITY_MAX_STREAM_OBJECTS){
-				     JSON_FAIL(JSON_TEXT("Maximum number of json objects for a stream at once has been reached"));
-					 if (err_call) err_call(getIdentifier());
-					 state = false;
-				     return;
-			     }
-			  #endif
-			  START_MEM_SCOPE
-				 JSONNode temp(JSONWorker::parse(buffer.substr(pos, end - pos + 1)));
-				 call(temp, getIdentifier());
-			  END_MEM_SCOPE
-			  json_string::iterator beginning = buffer.begin();
-			  buffer.erase(beginning, beginning + end);
-			  continue; //parse();  //parse the next object too
-		   }
-		   #ifdef JSON_SAFE
-				else {
-					//verify that what's in there is at least valid so far
-					#ifndef JSON_VALIDATE
-						#error In order to use safe mode and streams, JSON_VALIDATE needs to be defined
+	if (json_unlikely(scanned == buffer.length())) return;
+	JSONNode records(JSON_ARRAY);
+	pending_records pending(*this);
+
+	//finished objects are parsed right out of the buffer, they're never looked at again so it's fine to strip them where they are
+	json_char * const data = &buffer[0];
+	const json_char * const end = data + buffer.length();
+	const json_char * p = data + scanned;
+	while (p != end){
+		if (in_string){
+			if (json_unlikely(escaped)){
+				escaped = false;
+				++p;
+				continue;
+			}
+			for(; p != end; ++p){
+				if (*p == JSON_TEXT('\\')){
+					if (json_unlikely(++p == end)){
+						escaped = true;
+						break;
+					}
+				} else if (*p == JSON_TEXT('\"')){
+					in_string = false;
+					++p;
+					break;
+				}
+			}
+			continue;
+		}
+
+		if (depth == 0){
+			for(; p != end; ++p){
+				if ((*p == JSON_TEXT('{')) || (*p == JSON_TEXT('['))) break;
+			}
+			if (p == end) break;
+			start = p - data;
+			#ifdef JSON_SAFE
+				checked = 0;
+			#endif
+		}
+
+		switch (*p++){
+			case JSON_TEXT('\"'):
+				in_string = true;
+				break;
+			case JSON_TEXT('{'):
+			case JSON_TEXT('['):
+				++depth;
+				break;
+			case JSON_TEXT('}'):
+			case JSON_TEXT(']'):
+				if (--depth == 0){
+					#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
+						if (++objects > JSON_SECURITY_MAX_STREAM_OBJECTS){
+							dispatch(data, pending, records);  //the ones before it are still fine
+							if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+							JSON_FAIL(JSON_TEXT("Maximum number of json objects for a stream at once has been reached"));
+							if (err_call) err_call(getIdentifier());
+							state = false;
+							return;
+						}
 					#endif
+					record(data, start, (p - data) - start, pending, records);
+				}
+				break;
+		}
+	}
 
-					json_auto<json_char> s;
-					size_t len;
-					s.set(JSONWorker::RemoveWhiteSpace(json_string(buffer.c_str() + pos), len, false));
+	dispatch(data, pending, records);
+	if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+	if (depth == 0){
+		buffer.clear();
+		rewind();
+		return;
+	}
+	compact();
+
+	#ifdef JSON_SAFE
+		//verify that what's in there is at least valid so far
+		#ifndef JSON_VALIDATE
+			#error In order to use safe mode and streams, JSON_VALIDATE needs to be defined
+		#endif
+
+		//checked again each time it doubles in size, so a big object coming in small pieces isn't validated over and over
+		const size_t pending_length = scanned - start;
+		if (pending_length >= (checked << 1)){
+			checked = pending_length;
+			json_auto<json_char> s;
+			size_t len;
+			s.set(JSONWorker::RemoveWhiteSpace(buffer.data() + start, pending_length, len, false));
+
+			if (!JSONValidator::isValidPartialRoot(s.ptr)){
+				if (err_call) err_call(getIdentifier());
+				state = false;
+			}
+		}
+	#endif
+}
+
+/*
+	Lines don't need any scanning inside of them, a record is everything up
+	to the next newline, which memchr finds much faster than looking at one
+	character at a time
+*/
+void JSONStream::parseLines(void) json_nothrow {
+	#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
+		size_t objects = 0;
+	#endif
+	if (json_unlikely(scanned == buffer.length())) return;
+	JSONNode records(JSON_ARRAY);
+	pending_records pending(*this);
 
+	json_char * const data = &buffer[0];
+	const json_char * const end = data + buffer.length();
+	for(const json_char * p = data + scanned; p != end;){
+		const json_char * newline = (const json_char *)json_memchr(p, JSON_TEXT('\n'), end - p);
+		if (newline == 0) break;
+		#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
+			if (++objects > JSON_SECURITY_MAX_STREAM_OBJECTS){
+				dispatch(data, pending, records);
+				if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+				JSON_FAIL(JSON_TEXT("Maximum number of json objects for a stream at once has been reached"));
+				if (err_call) err_call(getIdentifier());
+				state = false;
+				return;
+			}
+		#endif
+		record(data, start, (newline - data) - start, pending, records);
+		start = (newline - data) + 1;
+		p = newline + 1;
+	}
 
-					if (!JSONValidator::isValidPartialRoot(s.ptr)){
-						if (err_call) err_call(getIdentifier());
-						state = false;
+	dispatch(data, pending, records);
+	if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+	if (start == buffer.length()){
+		buffer.clear();
+		rewind();
+		return;
+	}
+	compact();
+}
+
+/*
+	Only the containers on the way to the array are looked at closely,
+	anything else is skipped the same way parse skips through an object,
+	by its brackets and strings, so the only things kept in the buffer are
+	the element that's being read and the key that's being read
+*/
+void JSONStream::parseElements(void) json_nothrow {
+	#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
+		size_t objects = 0;
+	#endif
+	if (json_unlikely(scanned == buffer.length())) return;
+	JSONNode records(JSON_ARRAY);
+	pending_records pending(*this);
+
+	json_char * const data = &buffer[0];
+	const json_char * const end = data + buffer.length();
+	const json_char * p = data + scanned;
+	while (p != end){
+		if (in_string){
+			if (json_unlikely(escaped)){
+				escaped = false;
+				++p;
+				continue;
+			}
+			for(; p != end; ++p){
+				if (*p == JSON_TEXT('\\')){
+					if (json_unlikely(++p == end)){
+						escaped = true;
+						break;
+					}
+				} else if (*p == JSON_TEXT('\"')){
+					in_string = false;
+					if (in_key){
+						const size_t len = (p - data) - key;
+						hit = (len == want.length()) && (std::memcmp(want.data(), data + key, len * sizeof(json_char)) == 0);
+						in_key = false;
+					}
+					++p;
+					break;
+				}
+			}
+			continue;
+		}
+
+		if (depth == 0){
+			for(; p != end; ++p){
+				if ((*p == JSON_TEXT('{')) || (*p == JSON_TEXT('['))) break;
+			}
+			if (p == end) break;
+			++depth;
+			aim(*p++ == JSON_TEXT('{'));
+			continue;
+		}
+
+		const bool on_path = !past && (depth == matched + 1);
+		if (on_path && (matched == tokens)){
+			//straight inside of the array, this is where elements start and end
+			switch (*p){
+				case JSON_TEXT(' '):
+				case JSON_TEXT('\t'):
+				case JSON_TEXT('\n'):
+				case JSON_TEXT('\r'):
+					++p;
+					continue;
+				case JSON_TEXT(','):
+				case JSON_TEXT(']'):
+				case JSON_TEXT('}'):
+					if (element != json_string::npos){
+						#ifdef JSON_SECURITY_MAX_STREAM_OBJECTS
+							if (++objects > JSON_SECURITY_MAX_STREAM_OBJECTS){
+								dispatch(data, pending, records);
+								if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+								JSON_FAIL(JSON_TEXT("Maximum number of json objects for a stream at once has been reached"));
+								if (err_call) err_call(getIdentifier());
+								state = false;
+								return;
+							}
+						#endif
+						record(data, element, (p - data) - element, pending, records);
+						element = json_string::npos;
+					}
+					if (*p++ != JSON_TEXT(',')){
+						past = true;
+						if (--depth == 0) rewindPath();
+					}
+					continue;
+				default:
+					if (element == json_string::npos) element = p - data;
+					break;
+			}
+		}
+
+		switch (*p++){
+			case JSON_TEXT('\"'):
+				in_string = true;
+				if (on_path && expect_key){
+					in_key = true;
+					key = p - data;
+				}
+				break;
+			case JSON_TEXT(':'):
+				if (on_path) expect_key = false;
+				break;
+			case JSON_TEXT(','):
+				if (on_path){
+					if (in_object){
+						expect_key = true;
+						hit = false;
+					} else {
+						hit = (++index == want_index);
 					}
 				}
-		   #endif
+				break;
+			case JSON_TEXT('{'):
+			case JSON_TEXT('['):
+				++depth;
+				if (on_path && hit && !expect_key && (matched != tokens)){
+					++matched;
+					aim(p[-1] == JSON_TEXT('{'));
+				}
+				break;
+			case JSON_TEXT('}'):
+			case JSON_TEXT(']'):
+				if (on_path){
+					//closed without ever getting to the next part of the pointer
+					JSON_FAIL(JSON_TEXT("JSON pointer for a stream doesn't lead to an array"));
+					if (err_call) err_call(getIdentifier());
+					past = true;
+				}
+				if (--depth == 0) rewindPath();
+				break;
+		}
+	}
+
+	dispatch(data, pending, records);
+	if (batch_call && !records.empty()) batch_call(records, getIdentifier());
+	if (depth == 0){
+		buffer.clear();
+		rewind();
+		return;
+	}
+
+	//everything before the key or the element that's being read is done with
+	start = in_key ? key : ((element != json_string::npos) ? element : buffer.length());
+	const size_t before = start;
+	compact();
+	const size_t moved = before - start;
+	if (in_key) key -= moved;
+	if (element != json_string::npos) element -= moved;
+}
+
+//the scan just went into the container that's on the way, so it looks for the next part of the pointer
+void JSONStream::aim(bool object) json_nothrow {
+	in_object = object;
+	hit = false;
+	expect_key = object;
+	index = 0;
+	if (matched == tokens){
+		element = json_string::npos;
+		if (object){
+			JSON_FAIL(JSON_TEXT("JSON pointer for a stream doesn't lead to an array"));
+			if (err_call) err_call(getIdentifier());
+			past = true;
+		}
+		return;
+	}
+
+	size_t pos = 0;
+	for(size_t i = 0; i <= matched; ++i){
+		JSONWorker::PointerToken(path, pos, want);  //already checked by set_elements
+	}
+	if (!object){
+		json_index_t i;
+		if (JSONWorker::PointerIndex(want, i)){
+			want_index = i;
+			hit = (want_index == 0);
+		} else {
+			want_index = json_string::npos;  //never reached
+		}
+	}
+}
+
+/*
+	What a finished record turns into, a line that's blank gives nothing and
+	a line or element that isn't valid sets bad.  This is what the threads call, so it
+	mustn't change anything in the stream
+*/
+JSONNode * JSONStream::recordNode(json_char * text, size_t len, bool & bad) const json_nothrow {
+	if (!lines && !elements){
+		JSONNode temp(JSONWorker::parse_scratch(text, len));
+		return JSONNode::newJSONNode_Shallow(temp);
+	}
+
+	#ifdef JSON_UTF8
+		if (json_unlikely(!JSONUtf8::isValid(text, len))){
+			bad = true;
+			return 0;
 		}
-		break;
+	#endif
+
+	//the validator wants the quotes left alone, which is also what a value that isn't an object or an array is made from
+	json_auto<json_char> s;
+	size_t stripped;
+	s.set(JSONWorker::RemoveWhiteSpace(text, len, stripped, false));
+	if (stripped == 0) return 0;  //a blank line
+	if (json_unlikely(!JSONValidator::isValidValue(s.ptr))){
+		bad = true;
+		return 0;
+	}
+
+	JSONNode temp(((*s.ptr == JSON_TEXT('{')) || (*s.ptr == JSON_TEXT('['))) ? JSONWorker::parse_scratch(text, len) : JSONWorker::ValueNode(s.ptr, stripped));
+	return JSONNode::newJSONNode_Shallow(temp);
+}
+
+void JSONStream::deliver(JSONNode * record, bool bad, JSONNode & records) json_nothrow {
+	if (bad){
+		if (err_call) err_call(getIdentifier());
+		return;
+	}
+	if (record == 0) return;
+	if (batch_call){
+		records.push_back(*record);
+	} else {
+		call(*record, getIdentifier());
+	}
+	JSONNode::deleteJSONNode(record);
+}
+
+/*
+	The records that were finished stay in front of the unfinished one
+	until they take up more room than it does, so the bytes moved are
+	never more than the ones that have been used up
+*/
+void JSONStream::compact(void) json_nothrow {
+	if (start && (start >= buffer.length() - start)){
+		buffer.erase(0, start);
+		start = 0;
 	}
+	scanned = buffer.length();
 }
 
 #endif
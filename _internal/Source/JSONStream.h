@@ -13,21 +13,37 @@
 	#endif
 #endif
 
-#ifdef JSON_MEMORY_CALLBACKS
 #include "JSONMemory.h"
-#endif
 
 class JSONNode; //foreward declaration
 typedef void (*json_stream_callback_t)(JSONNode &, void *);
+typedef void (*json_stream_batch_callback_t)(JSONNode &, void *);  //gets an array of everything that one append finished
+
+/*
+	With lines set, the text is newline delimited json (JSON Lines), every
+	line is a record of its own and can be any value, not just an object or
+	an array.  A record is only finished once its newline comes in, blank
+	lines are skipped, and a line that isn't valid goes to the error
+	callback without stopping the lines after it.
+*/
 
 class JSONStream {
 public:
 	LIBJSON_OBJECT(JSONStream);
-    JSONStream(json_stream_callback_t call_p, json_stream_e_callback_t call_e = NULL, void * callbackIdentifier = JSONSTREAM_SELF) json_nothrow;
+    JSONStream(json_stream_callback_t call_p, json_stream_e_callback_t call_e = NULL, void * callbackIdentifier = JSONSTREAM_SELF, bool lines_p = false) json_nothrow;
     JSONStream(const JSONStream & orig) json_nothrow;
     JSONStream & operator =(const JSONStream & orig) json_nothrow;
 	~JSONStream(void) json_nothrow { LIBJSON_DTOR; }
 	JSONStream & operator << (const json_string & str) json_nothrow;
+	JSONStream & append(const json_char * str, size_t len) json_nothrow;
+	#ifdef JSON_STRING_VIEW
+		inline JSONStream & operator << (json_string_view str) json_nothrow {
+			return append(str.data(), str.length());
+		}
+		inline JSONStream & operator << (const json_char * str) json_nothrow {  //otherwise it's ambiguous
+			return append(str, json_strlen(str));
+		}
+	#endif
 	
     static void deleteJSONStream(JSONStream * stream) json_nothrow {
 #ifdef JSON_MEMORY_CALLBACKS
@@ -38,17 +54,52 @@ public:
 #endif
     }
 
-    static JSONStream * newJSONStream(json_stream_callback_t callback, json_stream_e_callback_t call_e, void * callbackIdentifier) json_nothrow {
+    static JSONStream * newJSONStream(json_stream_callback_t callback, json_stream_e_callback_t call_e, void * callbackIdentifier, bool lines_p = false) json_nothrow {
 #ifdef JSON_MEMORY_CALLBACKS
-		return new(json_malloc<JSONStream>(1)) JSONStream(callback, call_e, callbackIdentifier);
+		return new(json_malloc<JSONStream>(1)) JSONStream(callback, call_e, callbackIdentifier, lines_p);
 #else
-		return new JSONStream(callback, call_e, callbackIdentifier);
+		return new JSONStream(callback, call_e, callbackIdentifier, lines_p);
 #endif
     }
 
+	//once this is set the records are given to it all together after each append, instead of one at a time to the callback
+	inline void set_batch_callback(json_stream_batch_callback_t batch_p) json_nothrow {
+		batch_call = batch_p;
+	}
+
+	/*
+		Hands the finished records to threads, which parse them all the way
+		through and then call the callback.  With ordered, the threads only
+		parse and the records are still given out in order on this thread
+		afterwards, otherwise the callbacks are made on the threads in
+		whatever order they finish, so they must be safe to call at the same
+		time.  A batch callback is always called on this thread.  At most
+		in_flight records are handed out at once, and append doesn't return
+		until they've all been dealt with.  0 threads uses one for every
+		processor and 0 in_flight is 64 for each thread
+	*/
+	void set_parallel(unsigned int threads_p = 0, bool ordered_p = true, size_t in_flight_p = 0) json_nothrow;
+
+	/*
+		Instead of waiting for the whole of each document, gives out every
+		element of the array that the JSON pointer leads to as soon as that
+		element closes, so a huge array only ever needs as much memory as
+		its biggest element.  "" is the root array, "/items" is the array
+		in the root's items member.  Whatever isn't on the way to the array
+		is skipped over without being kept, an element that isn't valid
+		goes to the error callback without stopping the ones after it, and
+		if the pointer leads to something that isn't an array that goes to
+		the error callback too.  Once the array closes the rest of that
+		document is skipped.  Keys are compared the way they're written, so
+		one with escapes in it won't match.  Set it before anything is
+		appended, it has nothing to do with newline delimited streams
+	*/
+	void set_elements(const json_string & pointer) json_nothrow;
+
 	inline void reset() json_nothrow {
 		state = true;
 		buffer.clear();
+		rewind();
 	}
 JSON_PRIVATE
 	inline void * getIdentifier(void) json_nothrow {
@@ -58,19 +109,100 @@ JSON_PRIVATE
 		return callback_identifier;
 	}
 
-	#if (JSON_READ_PRIORITY == JSON_PRIO_HIGH) && (!(defined(JSON_LESS_MEMORY)))
-		template<json_char ch>
-		static size_t FindNextRelevant(const json_string & value_t, const size_t pos) json_nothrow json_read_priority;
-	#else
-		static size_t FindNextRelevant(json_char ch, const json_string & value_t, const size_t pos) json_nothrow json_read_priority;
-	#endif
+	//forgets where the scan was, for when the buffer is emptied
+	inline void rewind(void) json_nothrow {
+		scanned = 0;
+		start = 0;
+		depth = 0;
+		#ifdef JSON_SAFE
+			checked = 0;
+		#endif
+		in_string = false;
+		escaped = false;
+		rewindPath();
+	}
+
+	//starts again from the top of the path, for each document
+	inline void rewindPath(void) json_nothrow {
+		matched = 0;
+		index = 0;
+		element = json_string::npos;
+		in_key = false;
+		in_object = false;
+		expect_key = false;
+		hit = false;
+		past = false;
+	}
+
+	//the spans of finished records that are waiting for the threads
+	struct pending_records {
+		pending_records(const JSONStream & stream) json_nothrow;
+		json_auto<size_t> spans;
+		size_t count;
+		size_t size;  //0 when the records are done right away instead
+	private:
+		pending_records(const pending_records &);
+		pending_records & operator =(const pending_records &);
+	};
 
     void parse(void) json_nothrow;
+    void parseLines(void) json_nothrow;
+    void parseElements(void) json_nothrow;
+	void aim(bool object) json_nothrow;
+	inline void record(json_char * data, size_t pos, size_t len, pending_records & pending, JSONNode & records) json_nothrow;
+	void dispatch(json_char * data, pending_records & pending, JSONNode & records) json_nothrow;
+	static void parseRecords(void * arg) json_nothrow;  //what each of the threads runs
+	JSONNode * recordNode(json_char * text, size_t len, bool & bad) const json_nothrow;
+	void deliver(JSONNode * record, bool bad, JSONNode & records) json_nothrow;
+	void compact(void) json_nothrow;
     json_string buffer;
     json_stream_callback_t call;
 	json_stream_e_callback_t err_call;
+	json_stream_batch_callback_t batch_call;
 	void * callback_identifier;
+	unsigned int threads;
+	size_t in_flight;
+
+	/*
+		Where the scan got to, so that every chunk carries on from there and
+		nothing already in the buffer is looked at again.  start is where the
+		object (or line) that hasn't finished yet begins and depth is how many
+		brackets deep the scan is inside of it
+	*/
+	size_t scanned;
+	size_t start;
+	size_t depth;
+	#ifdef JSON_SAFE
+		size_t checked;  //how much of the unfinished object has been validated
+	#endif
+	/*
+		For set_elements, matched is how many of the pointer's tokens the
+		scan is inside of, so the container that's on the way to the array
+		is always matched + 1 deep.  want is the next token and index is
+		which element of that container the scan is on, element is where
+		the element of the array that's being read starts and key is where
+		the key being read starts, both are kept in the buffer
+	*/
+	json_string path;
+	json_string want;
+	size_t tokens;
+	size_t matched;
+	size_t index;
+	size_t want_index;
+	size_t element;
+	size_t key;
+
 	bool state BITS(1);
+	bool lines BITS(1);
+	bool elements BITS(1);
+	bool in_key BITS(1);
+	bool in_object BITS(1);  //the container on the way is an object
+	bool expect_key BITS(1);  //the container on the way is an object that's waiting for a key
+	bool hit BITS(1);  //the value being read is the next one on the way
+	bool past BITS(1);  //the array already closed, the rest of the document doesn't matter
+	bool ordered BITS(1);
+	bool in_string BITS(1);
+	bool escaped BITS(1);  //the last thing scanned was a backslash in a string
 };
 
 #ifdef JSON_LESS_MEMORY
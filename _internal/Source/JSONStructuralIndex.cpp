@@ -0,0 +1,78 @@
+#include "JSONStructuralIndex.h"
+
+#ifdef JSON_STRUCTURAL_INDEX
+
+JSONStructuralIndex * JSONStructuralIndex::newIndex(const json_char * json, size_t len) json_nothrow {
+    //positions are stored as json_index_t to keep the index small
+    if (json_unlikely(len >= (size_t)npos)) return 0;
+
+    #ifdef JSON_MEMORY_CALLBACKS
+	   JSONStructuralIndex * result = new(json_malloc<JSONStructuralIndex>(1)) JSONStructuralIndex();
+    #else
+	   JSONStructuralIndex * result = new JSONStructuralIndex();
+    #endif
+
+    //the entries of the brackets that are still open
+    json_auto<json_index_t> open(16);
+    size_t depth = 0;
+    size_t opencapacity = 16;
+
+    const json_char * const end = json + len;
+    for(const json_char * p = json; p != end; ++p){
+	   switch(*p){
+		  case JSON_TEXT('\"'):
+			 while (++p != end){
+				if (*p == JSON_TEXT('\\')){
+				    if (json_unlikely(++p == end)) goto fail;
+				} else if (*p == JSON_TEXT('\"')){
+				    break;
+				}
+			 }
+			 if (json_unlikely(p == end)) goto fail;
+			 break;
+		  #ifdef JSON_COMMENTS
+			 case JSON_TEMP_COMMENT_IDENTIFIER:
+				while (++p != end && *p != JSON_TEMP_COMMENT_IDENTIFIER){}
+				if (json_unlikely(p == end)) goto fail;
+				break;
+		  #endif
+		  case JSON_TEXT('{'):
+		  case JSON_TEXT('['):
+			 if (json_unlikely(depth == opencapacity)){
+				opencapacity <<= 1;
+				open.ptr = json_realloc<json_index_t>(open.ptr, opencapacity);
+			 }
+			 open.ptr[depth++] = result -> push_back(p - json);
+			 break;
+		  case JSON_TEXT('}'):
+		  case JSON_TEXT(']'): {
+			 if (json_unlikely(depth == 0)) goto fail;
+			 const json_index_t opener = open.ptr[--depth];
+			 if (json_unlikely(json[result -> array[opener].position] != ((*p == JSON_TEXT('}')) ? JSON_TEXT('{') : JSON_TEXT('[')))) goto fail;
+			 const json_index_t closer = result -> push_back(p - json);
+			 result -> array[opener].match = closer;
+			 break;
+		  }
+		  case JSON_TEXT(','):
+		  case JSON_TEXT(':'):
+			 result -> push_back(p - json);
+			 break;
+	   }
+    }
+    if (json_likely(depth == 0)) return result;
+
+fail:
+    deleteIndex(result);
+    return 0;
+}
+
+void JSONStructuralIndex::deleteIndex(JSONStructuralIndex * ptr) json_nothrow {
+    #ifdef JSON_MEMORY_CALLBACKS
+	   ptr -> ~JSONStructuralIndex();
+	   libjson_free<JSONStructuralIndex>(ptr);
+    #else
+	   delete ptr;
+    #endif
+}
+
+#endif
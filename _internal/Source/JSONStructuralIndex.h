@@ -0,0 +1,108 @@
+#ifndef JSON_STRUCTURAL_INDEX_H
+#define JSON_STRUCTURAL_INDEX_H
+
+#include "JSONDebug.h"
+#include "JSONMemory.h"
+
+/*
+ *	Lazily fetched containers used to find their children by calling
+ *	FindNextRelevant over and over, which rescans every nested level each
+ *	time a parent is fetched.  This class walks the text once and records
+ *	where every bracket, comma and colon that is outside of a string lives,
+ *	along with where each bracket is closed.  Children then find their members
+ *	by hopping from one structural character to the next, skipping entire
+ *	nested containers in one step.
+ *
+ *	The index is reference counted, it is shared by every unfetched container
+ *	that was sliced out of the same text, and is released once they are all
+ *	fetched.  It isn't used in JSON_LESS_MEMORY mode.
+ */
+
+#if defined(JSON_READ_PRIORITY) && !defined(JSON_LESS_MEMORY)
+    #define JSON_STRUCTURAL_INDEX
+#endif
+
+#ifdef JSON_STRUCTURAL_INDEX
+    #define STRUCTURAL_PARAM , JSONStructuralIndex * index, json_index_t entry
+    #define STRUCTURAL_ARG(index, entry) , index, entry
+#else
+    #define STRUCTURAL_PARAM
+    #define STRUCTURAL_ARG(index, entry)
+#endif
+
+#ifdef JSON_STRUCTURAL_INDEX
+
+class JSONStructuralIndex {
+public:
+	LIBJSON_OBJECT(JSONStructuralIndex);
+    static const json_index_t npos = (json_index_t)-1;
+
+    //builds an index over the text, returns 0 if the brackets don't line up
+    static JSONStructuralIndex * newIndex(const json_char * json, size_t len) json_nothrow json_read_priority;
+    static void deleteIndex(JSONStructuralIndex * ptr) json_nothrow;
+
+    inline JSONStructuralIndex * incRef(void) json_nothrow {
+	   ++refcount;
+	   return this;
+    }
+
+    //releases a reference, deleting the index when nothing is using it anymore
+    static inline void decRef(JSONStructuralIndex * & ptr) json_nothrow {
+	   if (ptr != 0){
+		  JSON_ASSERT(ptr -> refcount != 0, JSON_TEXT("decRef on a 0 refcount index"));
+		  if (--(ptr -> refcount) == 0) deleteIndex(ptr);
+		  ptr = 0;
+	   }
+    }
+
+    //where in the text the structural character lives
+    inline size_t position(json_index_t entry) const json_nothrow {
+	   JSON_ASSERT(entry < mysize, JSON_TEXT("Structural index out of bounds"));
+	   return array[entry].position;
+    }
+
+    //for opening brackets, the entry of its closing bracket
+    inline json_index_t match(json_index_t entry) const json_nothrow {
+	   JSON_ASSERT(entry < mysize, JSON_TEXT("Structural index out of bounds"));
+	   return array[entry].match;
+    }
+
+    inline json_index_t size(void) const json_nothrow {
+	   return mysize;
+    }
+
+    JSON_PRIVATE
+    struct structural {
+	   json_index_t position;
+	   json_index_t match;
+    };
+
+    JSONStructuralIndex(void) json_nothrow : array(0), mysize(0), mycapacity(0), refcount(1) {
+	   LIBJSON_CTOR;
+    }
+    ~JSONStructuralIndex(void) json_nothrow {
+	   if (array != 0) libjson_free<structural>(array);
+	   LIBJSON_DTOR;
+    }
+    inline json_index_t push_back(size_t pos) json_nothrow {
+	   if (json_unlikely(mysize == mycapacity)){
+		  mycapacity = (mycapacity == 0) ? 16 : mycapacity << 1;
+		  array = json_realloc<structural>(array, mycapacity);
+	   }
+	   array[mysize].position = (json_index_t)pos;
+	   array[mysize].match = npos;
+	   return mysize++;
+    }
+
+    structural * array;
+    json_index_t mysize;
+    json_index_t mycapacity;
+    size_t refcount;
+private:
+    JSONStructuralIndex(const JSONStructuralIndex &);
+    JSONStructuralIndex & operator = (const JSONStructuralIndex &);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#include "JSONThreads.h"
+
+#ifdef JSON_THREADS
+
+#include "JSONMemory.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+	   #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+	   #define NOMINMAX
+    #endif
+    #include <windows.h>
+    typedef HANDLE json_thread_t;
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    typedef pthread_t json_thread_t;
+#endif
+
+struct json_thread_job {
+    JSONThreads::work_t work;
+    void * arg;
+};
+
+#ifdef _WIN32
+    static DWORD WINAPI threadMain(LPVOID param){
+	   json_thread_job * job = (json_thread_job *)param;
+	   job -> work(job -> arg);
+	   return 0;
+    }
+#else
+    extern "C" {
+	   static void * threadMain(void * param){
+		  json_thread_job * job = (json_thread_job *)param;
+		  job -> work(job -> arg);
+		  return 0;
+	   }
+    }
+#endif
+
+void JSONThreads::run(unsigned int count, work_t work, void * arg) json_nothrow {
+    JSON_ASSERT(count != 0, JSON_TEXT("running work on no threads"));
+    json_thread_job job;
+    job.work = work;
+    job.arg = arg;
+
+    //if the system won't give us as many threads as were asked for, the ones that did start just take more of the work
+    json_auto<json_thread_t> threads(count);
+    unsigned int started = 0;
+    for(; started < count - 1; ++started){
+	   #ifdef _WIN32
+		  threads.ptr[started] = CreateThread(0, 0, threadMain, &job, 0, 0);
+		  if (json_unlikely(threads.ptr[started] == 0)) break;
+	   #else
+		  if (json_unlikely(pthread_create(&threads.ptr[started], 0, threadMain, &job) != 0)) break;
+	   #endif
+    }
+
+    work(arg);
+
+    for(unsigned int i = 0; i < started; ++i){
+	   #ifdef _WIN32
+		  WaitForSingleObject(threads.ptr[i], INFINITE);
+		  CloseHandle(threads.ptr[i]);
+	   #else
+		  pthread_join(threads.ptr[i], 0);
+	   #endif
+    }
+}
+
+unsigned int JSONThreads::hardware(void) json_nothrow {
+    #ifdef _WIN32
+	   SYSTEM_INFO info;
+	   GetSystemInfo(&info);
+	   return (info.dwNumberOfProcessors != 0) ? (unsigned int)info.dwNumberOfProcessors : 1;
+    #else
+	   const long res = sysconf(_SC_NPROCESSORS_ONLN);
+	   return (res > 0) ? (unsigned int)res : 1;
+    #endif
+}
+
+size_t JSONThreads::fetchAdd(volatile size_t & value) json_nothrow {
+    #ifdef _WIN64
+	   return (size_t)InterlockedExchangeAdd64((volatile LONG64 *)&value, 1);
+    #elif defined(_WIN32)
+	   return (size_t)InterlockedExchangeAdd((volatile LONG *)&value, 1);
+    #else
+	   return __sync_fetch_and_add(&value, (size_t)1);
+    #endif
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef JSON_THREADS_H
+#define JSON_THREADS_H
+
+#include "JSONDebug.h"
+
+/*
+ *	Just enough of the platform's threads for preparse_parallel to spread
+ *	work over every core.  The workers pull their next piece of work off of a
+ *	shared counter, so one that gets handed a few large children doesn't hold
+ *	up the others, they just go on taking what's left.
+ *
+ *	Nothing else in libjson is aware of threads, so the work handed out must
+ *	never touch anything that another thread can see.  It is turned off with
+ *	JSON_NO_THREADS, and always with the memory pool or memory manager, since
+ *	those keep global state without any locks.
+ */
+
+#if !defined(JSON_NO_THREADS) && !defined(JSON_MEMORY_POOL) && !defined(JSON_MEMORY_MANAGE)
+    #if defined(_WIN32) || defined(__unix__) || defined(__APPLE__)
+	   #define JSON_THREADS
+    #endif
+#endif
+
+#ifdef JSON_THREADS
+
+class JSONThreads {
+public:
+    typedef void (*work_t)(void * arg);
+
+    //runs work(arg) on count threads, the calling thread being one of them, and waits for them all to finish
+    static void run(unsigned int count, work_t work, void * arg) json_nothrow;
+
+    //how many processors there are to run on
+    static unsigned int hardware(void) json_nothrow;
+
+    //adds one to value and returns what it was before, without any other thread seeing it half done
+    static size_t fetchAdd(volatile size_t & value) json_nothrow;
+private:
+    JSONThreads(void);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+#include "JSONUtf8.h"
+
+#ifndef JSON_UNICODE
+
+#include <cstring>  //memcpy
+
+//the high bit of each of the eight bytes
+#define JSON_UTF8_HIGH_BITS 0x8080808080808080ULL
+
+bool JSONUtf8::scan(const json_char * text, size_t len) json_nothrow {
+    const unsigned char * p = (const unsigned char *)text;
+    const unsigned char * const end = p + len;
+    while (p != end){
+	   unsigned long long block;
+	   while ((end - p) >= 8){
+		  std::memcpy(&block, p, 8);  //unaligned, memcpy is the one way to do that which every compiler turns into a load
+		  if (block & JSON_UTF8_HIGH_BITS) break;
+		  p += 8;
+	   }
+	   if (p == end) break;
+
+	   const unsigned char lead = *p;
+	   if (lead < 0x80){
+		  ++p;
+		  continue;
+	   }
+
+	   //how many continuation bytes there are, and the range that the first one has to be in
+	   size_t following;
+	   unsigned char low = 0x80, high = 0xBF;
+	   if (lead < 0xC2){  //a continuation byte on its own, or the start of an overlong two byte sequence
+		  return false;
+	   } else if (lead < 0xE0){
+		  following = 1;
+	   } else if (lead < 0xF0){
+		  following = 2;
+		  if (lead == 0xE0){
+			 low = 0xA0;  //overlong
+		  } else if (lead == 0xED){
+			 high = 0x9F;  //surrogates
+		  }
+	   } else if (lead < 0xF5){
+		  following = 3;
+		  if (lead == 0xF0){
+			 low = 0x90;  //overlong
+		  } else if (lead == 0xF4){
+			 high = 0x8F;  //past U+10FFFF
+		  }
+	   } else {
+		  return false;
+	   }
+
+	   if (json_unlikely((size_t)(end - p) <= following)) return false;
+	   if ((p[1] < low) || (p[1] > high)) return false;
+	   for(size_t i = 2; i <= following; ++i){
+		  if ((p[i] & 0xC0) != 0x80) return false;
+	   }
+	   p += following + 1;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef JSON_UTF8_H
+#define JSON_UTF8_H
+
+#include "JSONDebug.h"
+
+#include "JSONSimd.h"
+
+/*
+ *	Checks that narrow text is well formed UTF-8: no stray continuation
+ *	bytes, no sequences cut short, nothing encoded with more bytes than it
+ *	needs, no surrogates and nothing past U+10FFFF.  With AVX2 that is done
+ *	32 bytes at a time with JSONSimd's lookup tables, otherwise plain ascii
+ *	is skipped eight bytes at a time, since that is what most of any json is,
+ *	and the rest is checked a byte at a time.
+ *
+ *	Wide strings are already code points, so there is nothing to check.
+ */
+
+#ifndef JSON_UNICODE
+
+class JSONUtf8 {
+public:
+    static inline bool isValid(const json_char * text, size_t len) json_nothrow {
+	   #ifdef JSON_SIMD
+		  return JSONSimd::ValidUtf8(text, text + len);
+	   #else
+		  return scan(text, len);
+	   #endif
+    }
+
+    //the check without any SIMD, which is also what JSONSimd falls back on
+    static bool scan(const json_char * text, size_t len) json_nothrow;
+private:
+    JSONUtf8(void);
+};
+
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include "JSONValidator.h"
+#include "JSONUtf8.h"
 
-#ifdef JSON_VALIDATE
+#if defined(JSON_VALIDATE) || defined(JSON_READ_PRIORITY)
 
 inline bool isHex(json_char c) json_pure;
 inline bool isHex(json_char c) json_nothrow {
@@ -313,7 +314,8 @@ bool JSONValidator::isValidString(const json_char * & ptr) json_nothrow {
 
 bool JSONValidator::isValidNamedObject(const json_char * &ptr  DEPTH_PARAM) json_nothrow {
     if (json_unlikely(!isValidString(++ptr))) return false;
-    if (json_unlikely(*ptr++ != JSON_TEXT(':'))) return false;
+    if (json_unlikely(*ptr != JSON_TEXT(':'))) return false;  //left on the end if it's cut off there, so a partial root can tell
+    ++ptr;
     if (json_unlikely(!isValidMember(ptr  DEPTH_ARG(depth_param)))) return false;
     switch(*ptr){
 	   case JSON_TEXT(','):
@@ -369,6 +371,9 @@ bool JSONValidator::isValidArray(const json_char * & ptr  DEPTH_PARAM) json_noth
 }
 
 bool JSONValidator::isValidRoot(const json_char * json) json_nothrow {
+    #ifdef JSON_UTF8
+	   if (json_unlikely(!JSONUtf8::isValid(json, json_strlen(json)))) return false;
+    #endif
     const json_char * ptr = json;
     switch(*ptr){
 	   case JSON_TEXT('{'):
@@ -385,6 +390,58 @@ bool JSONValidator::isValidRoot(const json_char * json) json_nothrow {
     return false;
 }
 
+/*
+	The grammar above relies on the null terminator to stop it, text that is
+	only known by its length might not have one.  As long as the quotes are
+	closed and the last bracket is the one that closes the first, the grammar
+	either gives up or consumes that last bracket at the root, so it can be
+	walked without ever looking past the end
+*/
+bool JSONValidator::isBalanced(const json_char * json, const json_char * const end) json_nothrow {
+    size_t depth = 0;
+    for(const json_char * p = json; p != end; ++p){
+	   switch(*p){
+		  case JSON_TEXT('\"'):
+			 while (++p != end){
+				if (*p == JSON_TEXT('\\')){
+				    if (json_unlikely(++p == end)) return false;
+				} else if (*p == JSON_TEXT('\"')){
+				    break;
+				}
+			 }
+			 if (json_unlikely(p == end)) return false;
+			 break;
+		  case JSON_TEXT('{'):
+		  case JSON_TEXT('['):
+			 ++depth;
+			 break;
+		  case JSON_TEXT('}'):
+		  case JSON_TEXT(']'):
+			 if (json_unlikely(depth == 0)) return false;
+			 if (--depth == 0) return p + 1 == end;
+			 break;
+	   }
+    }
+    return false;
+}
+
+bool JSONValidator::isValidRoot(const json_char * json, size_t len) json_nothrow {
+    if (json_unlikely(len == 0)) return false;
+    #ifdef JSON_UTF8
+	   if (json_unlikely(!JSONUtf8::isValid(json, len))) return false;
+    #endif
+    const json_char * const end = json + len;
+    if (json_unlikely(!isBalanced(json, end))) return false;
+    const json_char * ptr = json;
+    switch(*ptr){
+	   case JSON_TEXT('{'):
+		  return isValidObject(++ptr  DEPTH_ARG(1)) && (ptr == end);
+	   case JSON_TEXT('['):
+		  return isValidArray(++ptr  DEPTH_ARG(1)) && (ptr == end);
+    }
+    return false;
+}
+
 #ifdef JSON_STREAM
 //It has already been checked for a complete structure, so we know it's not complete
 bool JSONValidator::isValidPartialRoot(const json_char * json) json_nothrow {
@@ -399,6 +456,18 @@ bool JSONValidator::isValidPartialRoot(const json_char * json) json_nothrow {
     }
     return false;
 }
+
+//a whole line of newline delimited json, which can be any value at all
+bool JSONValidator::isValidValue(const json_char * json) json_nothrow {
+	const json_char * ptr = json;
+    switch(*ptr){
+		case JSON_TEXT('}'):  //a null inside of a container, but not by itself
+		case JSON_TEXT(']'):
+		case JSON_TEXT(','):
+			return false;
+    }
+    return isValidMember(ptr  DEPTH_ARG(0)) && (*ptr == JSON_TEXT('\0'));
+}
 #endif
 
 #endif
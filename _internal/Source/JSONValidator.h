@@ -3,7 +3,8 @@
 
 #include "JSONDebug.h"
 
-#ifdef JSON_VALIDATE
+//JSONSax walks the same grammar, so it is needed for reading too
+#if defined(JSON_VALIDATE) || defined(JSON_READ_PRIORITY)
 
 #ifdef JSON_SECURITY_MAX_NEST_LEVEL
     #define DEPTH_PARAM ,size_t depth_param
@@ -28,9 +29,13 @@ class JSONValidator {
 	   static bool isValidObject(const json_char * & ptr  DEPTH_PARAM) json_nothrow json_read_priority;
 	   static bool isValidArray(const json_char * & ptr  DEPTH_PARAM) json_nothrow json_read_priority;
 	   static bool isValidRoot(const json_char * json) json_nothrow json_read_priority;
+	   static bool isValidRoot(const json_char * json, size_t len) json_nothrow json_read_priority;
 		#ifdef JSON_STREAM
 			static bool isValidPartialRoot(const json_char * json) json_nothrow json_read_priority;
+			static bool isValidValue(const json_char * json) json_nothrow json_read_priority;
 		#endif
+	JSON_PRIVATE
+		static bool isBalanced(const json_char * json, const json_char * const end) json_nothrow json_read_priority;
 	private: 
 		JSONValidator(void);
 };
@@ -1,4 +1,7 @@
 #include "JSONWorker.h"
+#include "JSONSimd.h"
+#include "JSONUtf8.h"
+#include "JSONReader.h"
 
 bool used_ascii_one = false;  //used to know whether or not to check for intermediates when writing, once flipped, can't be unflipped
 inline json_char ascii_one(void) json_nothrow {
@@ -8,27 +11,31 @@ inline json_char ascii_one(void) json_nothrow {
 
 #ifdef JSON_READ_PRIORITY
 
-JSONNode JSONWorker::parse(const json_string & json) json_throws(std::invalid_argument) {
+JSONNode JSONWorker::parse(const json_char * json, size_t length) json_throws(std::invalid_argument) {
 	json_auto<json_char> s;
 	size_t len;
-	s.set(RemoveWhiteSpace(json, len, true));
+	s.set(RemoveWhiteSpace(json, length, len, true));
 	return _parse_unformatted(s.ptr, s.ptr + len);
 }
 
-JSONNode JSONWorker::parse_unformatted(const json_string & json) json_throws(std::invalid_argument) {
+//the text is only ever looked at between json and json + length, it doesn't need to be null terminated
+JSONNode JSONWorker::parse_unformatted(const json_char * json, size_t length) json_throws(std::invalid_argument) {
     #if defined JSON_DEBUG || defined JSON_SAFE
 	   #ifndef JSON_NO_EXCEPTIONS
-		  JSON_ASSERT_SAFE((json[0] == JSON_TEXT('{')) || (json[0] == JSON_TEXT('[')), JSON_TEXT("Not JSON!"), throw std::invalid_argument(json_global(EMPTY_STD_STRING)););
+		  JSON_ASSERT_SAFE((length != 0) && ((json[0] == JSON_TEXT('{')) || (json[0] == JSON_TEXT('['))), JSON_TEXT("Not JSON!"), throw std::invalid_argument(json_global(EMPTY_STD_STRING)););
 	   #else
-		  JSON_ASSERT_SAFE((json[0] == JSON_TEXT('{')) || (json[0] == JSON_TEXT('[')), JSON_TEXT("Not JSON!"), return JSONNode(JSON_NULL););
+		  JSON_ASSERT_SAFE((length != 0) && ((json[0] == JSON_TEXT('{')) || (json[0] == JSON_TEXT('['))), JSON_TEXT("Not JSON!"), return JSONNode(JSON_NULL););
 	   #endif
     #endif
-	return _parse_unformatted(json.data(), json.data() + json.length());
+    #if defined(JSON_UTF8) && defined(JSON_SAFE)
+	   JSON_ASSERT_SAFE(JSONUtf8::isValid(json, length), JSON_TEXT("Invalid UTF-8 detected"), return _parse_unformatted(json, json););  //which fails the same way as anything else that isn't json
+    #endif
+	return _parse_unformatted(json, json + length);
 }
 
-JSONNode JSONWorker::_parse_unformatted(const json_char * json, const json_char * const end) json_throws(std::invalid_argument) {
+JSONNode JSONWorker::_parse_unformatted(const json_char * json, const json_char * const end, bool insitu) json_throws(std::invalid_argument) {
     #ifdef JSON_COMMENTS
-	   json_char firstchar = *json;
+	   json_char firstchar = (json != end) ? *json : JSON_TEXT('\0');
 	   json_string _comment;
 	   json_char * runner = (json_char*)json;
 	   if (json_unlikely(firstchar == JSON_TEMP_COMMENT_IDENTIFIER)){  //multiple comments will be consolidated into one
@@ -44,7 +51,7 @@ JSONNode JSONWorker::_parse_unformatted(const json_char * json, const json_char
 		  }
 	   }
     #else
-	   const json_char firstchar = *json;
+	   const json_char firstchar = (json != end) ? *json : JSON_TEXT('\0');
     #endif
 
     switch (firstchar){
@@ -64,11 +71,11 @@ JSONNode JSONWorker::_parse_unformatted(const json_char * json, const json_char
 			 }
 		  #endif
 		  #ifdef JSON_COMMENTS
-			 JSONNode foo(json_string(runner, end - runner));
+			 JSONNode foo(insitu ? json_shared_string::borrow(runner, end - runner) : json_shared_string(runner, end - runner));
 			 foo.set_comment(_comment);
 			 return JSONNode(true, foo);  //forces it to simply return the original interal, even with ref counting off
 		  #else
-			 return JSONNode(json_string(json, end - json));
+			 return JSONNode(insitu ? json_shared_string::borrow(const_cast<json_char *>(json), end - json) : json_shared_string(json, end - json));
 		  #endif
     }
 
@@ -163,19 +170,28 @@ inline void SingleLineComment(const json_char * & p, const json_char * const end
 }
 #endif
 
+/*
+	Writes the stripped text to result and returns how long it is.  The
+	output never gets ahead of the input, so result may be the same buffer
+	as the text, as long as there is room for one more character after it
+*/
 #if defined(JSON_LESS_MEMORY) && defined(JSON_READ_PRIORITY)
-	#define PRIVATE_REMOVEWHITESPACE(T, value_t, escapeQuotes, len) private_RemoveWhiteSpace(T, value_t, escapeQuotes, len)
-	json_char * private_RemoveWhiteSpace(bool T, const json_string & value_t, bool escapeQuotes, size_t & len) json_nothrow {
+	#define PRIVATE_STRIPWHITESPACE(T, json, end, result, escapeQuotes) private_StripWhiteSpace(T, json, end, result, escapeQuotes)
+	size_t private_StripWhiteSpace(bool T, const json_char * json, const json_char * const end, json_char * const result, bool escapeQuotes) json_nothrow {
 #else
-	#define PRIVATE_REMOVEWHITESPACE(T, value_t, escapeQuotes, len) private_RemoveWhiteSpace<T>(value_t, escapeQuotes, len)
+	#define PRIVATE_STRIPWHITESPACE(T, json, end, result, escapeQuotes) private_StripWhiteSpace<T>(json, end, result, escapeQuotes)
 	template<bool T>
-	json_char * private_RemoveWhiteSpace(const json_string & value_t, bool escapeQuotes, size_t & len) json_nothrow {
+	size_t private_StripWhiteSpace(const json_char * json, const json_char * const end, json_char * const result, bool escapeQuotes) json_nothrow {
 #endif
-	json_char * result;
-	json_char * runner = result = json_malloc<json_char>(value_t.length() + 1);  //dealing with raw memory is faster than adding to a json_string
-	JSON_ASSERT(result != 0, json_global(ERROR_OUT_OF_MEMORY));
-	const json_char * const end = value_t.data() + value_t.length();
-	for(const json_char * p = value_t.data(); p != end; ++p){
+	#if defined(JSON_UTF8) && defined(JSON_SAFE)
+		JSON_ASSERT_SAFE(JSONUtf8::isValid(json, end - json), JSON_TEXT("Invalid UTF-8 detected"), return 0;);  //nothing at all is left, which every parser rejects
+	#endif
+	json_char * runner = result;
+	for(const json_char * p = json; p != end; ++p){
+	  #ifdef JSON_SIMD
+		 JSONSimd::RemoveWhiteSpace(p, end, runner);  //gets through the boring parts a block at a time
+		 if (json_unlikely(p == end)) break;
+	  #endif
 	  switch(*p){
 		 case JSON_TEXT(' '):   //defined as white space
 		 case JSON_TEXT('\t'):  //defined as white space
@@ -184,15 +200,16 @@ inline void SingleLineComment(const json_char * & p, const json_char * const end
 			break;
 		#ifndef JSON_STRICT
 			case JSON_TEXT('/'):  //a C comment
-				if (*(++p) == JSON_TEXT('*')){  //a multiline comment
+				if (json_unlikely(++p == end)) goto endofrunner;
+				if (*p == JSON_TEXT('*')){  //a multiline comment
 				   if (T) COMMENT_DELIMITER();
-				   while ((*(++p) != JSON_TEXT('*')) || (*(p + 1) != JSON_TEXT('/'))){
-					  if(p == end){
-							COMMENT_DELIMITER(); 
-							goto endofrunner;
-						}
+				   while ((++p != end) && ((*p != JSON_TEXT('*')) || (p + 1 == end) || (*(p + 1) != JSON_TEXT('/')))){
 					  if (T) *runner++ = *p;
 				   }
+				   if (p == end){
+					  COMMENT_DELIMITER(); 
+					  goto endofrunner;
+				   }
 				   ++p;
 				   if (T) COMMENT_DELIMITER();
 				   break;
@@ -209,11 +226,16 @@ inline void SingleLineComment(const json_char * & p, const json_char * const end
 		 #endif
 		 case JSON_TEXT('\"'):  //a quote
 			*runner++ = JSON_TEXT('\"');
-			while(*(++p) != JSON_TEXT('\"')){  //find the end of the quotation, as white space is preserved within it
-				if(p == end) goto endofrunner;
+			while((++p != end) && (*p != JSON_TEXT('\"'))){  //find the end of the quotation, as white space is preserved within it
+				#ifdef JSON_SIMD
+					JSONSimd::CopyString(p, end, runner);  //jumps to the next quote or backslash
+					if (p == end) goto endofrunner;
+					if (*p == JSON_TEXT('\"')) break;
+				#endif
 				switch(*p){
 				   case JSON_TEXT('\\'):
 					  *runner++ = JSON_TEXT('\\');
+					  if (json_unlikely(p + 1 == end)) goto endofrunner;
 					  if (escapeQuotes){
 							*runner++ = (*++p == JSON_TEXT('\"')) ? ascii_one() : *p;  //an escaped quote will reak havoc will all of my searching functions, so change it into an illegal character in JSON for convertion later on
 					  } else {
@@ -225,6 +247,7 @@ inline void SingleLineComment(const json_char * & p, const json_char * const end
 					  break;
 				}
 			}
+			if (json_unlikely(p == end)) goto endofrunner;
 			//no break, let it fall through so that the trailing quote gets added
 		 default:
 			JSON_ASSERT_SAFE((json_uchar)*p >= 32, JSON_TEXT("Invalid JSON character detected (lo)"), goto endofrunner;);
@@ -234,105 +257,232 @@ inline void SingleLineComment(const json_char * & p, const json_char * const end
 	  }
 	}
 	endofrunner:
-	len = runner - result;
+	return runner - result;
+}
+
+#if defined(JSON_LESS_MEMORY) && defined(JSON_READ_PRIORITY)
+	#define PRIVATE_REMOVEWHITESPACE(T, value_t, length, escapeQuotes, len) private_RemoveWhiteSpace(T, value_t, length, escapeQuotes, len)
+	json_char * private_RemoveWhiteSpace(bool T, const json_char * value_t, size_t length, bool escapeQuotes, size_t & len) json_nothrow {
+#else
+	#define PRIVATE_REMOVEWHITESPACE(T, value_t, length, escapeQuotes, len) private_RemoveWhiteSpace<T>(value_t, length, escapeQuotes, len)
+	template<bool T>
+	json_char * private_RemoveWhiteSpace(const json_char * value_t, size_t length, bool escapeQuotes, size_t & len) json_nothrow {
+#endif
+	json_char * result = json_malloc<json_char>(length + 1);  //dealing with raw memory is faster than adding to a json_string
+	JSON_ASSERT(result != 0, json_global(ERROR_OUT_OF_MEMORY));
+	len = PRIVATE_STRIPWHITESPACE(T, value_t, value_t + length, result, escapeQuotes);
 	return result;
 }
 
 #ifdef JSON_READ_PRIORITY
-    json_char * JSONWorker::RemoveWhiteSpace(const json_string & value_t, size_t & len, bool escapeQuotes) json_nothrow  {
-		json_char * result = PRIVATE_REMOVEWHITESPACE(true, value_t, escapeQuotes, len); 
+    json_char * JSONWorker::RemoveWhiteSpace(const json_char * value_t, size_t length, size_t & len, bool escapeQuotes) json_nothrow  {
+		json_char * result = PRIVATE_REMOVEWHITESPACE(true, value_t, length, escapeQuotes, len); 
 		result[len] = JSON_TEXT('\0');
 		return result;
     }
+
+    //the buffer is stripped where it is, and the document keeps pointing into it
+    JSONNode JSONWorker::parse_insitu(json_char * buf, size_t len) json_throws(std::invalid_argument) {
+		len = PRIVATE_STRIPWHITESPACE(true, buf, buf + len, buf, true);
+		return _parse_unformatted(buf, buf + len, true);
+    }
+
+    //the buffer is stripped where it is too, but the nodes get their own copies so it can be reused as soon as this returns
+    JSONNode JSONWorker::parse_scratch(json_char * buf, size_t len) json_throws(std::invalid_argument) {
+		len = PRIVATE_STRIPWHITESPACE(true, buf, buf + len, buf, true);
+		return _parse_unformatted(buf, buf + len);
+    }
+
+    /*
+		Follows the pointer through the text with a JSONReader, jumping over
+		every member and element that isn't on the path, so the only thing that
+		ever gets a node is the value at the end of it
+    */
+    JSONNode JSONWorker::extract(const json_char * json, size_t length, const json_string & pointer, size_t pos) json_throws(std::logic_error) {
+		JSONReader reader(json, length);
+		JSONReader::token current = reader.next();
+		json_string token;
+		bool named = false;
+		while (pos < pointer.length()){
+			if (json_unlikely(!PointerToken(pointer, pos, token))){
+				json_throw(std::invalid_argument(json_global(EMPTY_STD_STRING)));
+			}
+			switch(current){
+				case JSONReader::start_object:
+					while ((current = reader.next()) == JSONReader::key){
+						if (reader.key_equals(token)) break;
+						reader.skip_value();
+					}
+					if (json_unlikely(current != JSONReader::key)) goto missing;
+					current = reader.next();
+					named = true;
+					break;
+				case JSONReader::start_array:{
+					json_index_t index;
+					if (json_unlikely(!PointerIndex(token, index))) goto missing;
+					current = reader.next();
+					for(; index != 0 && (current != JSONReader::end_array) && (current != JSONReader::invalid); --index){
+						reader.skip_value();
+						current = reader.next();
+					}
+					if (json_unlikely(current == JSONReader::end_array)) goto missing;
+					named = false;
+					break;
+				}
+				default:
+					goto missing;
+			}
+		}
+
+		reader.skip_value();
+		if (json_unlikely(reader.current() == JSONReader::invalid)){
+			json_throw(std::invalid_argument(json_global(EMPTY_STD_STRING)));
+		} else {
+			size_t len;
+			json_auto<json_char> s;
+			s.set(PRIVATE_REMOVEWHITESPACE(false, reader.raw(), reader.raw_length(), true, len));
+			JSONNode res(internalJSONNode::newInternal(json_shared_string(), json_shared_string(s.ptr, len) STRUCTURAL_ARG(0, 0)));
+			if (named) res.set_name(token);
+			return res;
+		}
+
+		missing:
+		if (json_unlikely(current == JSONReader::invalid)){
+			json_throw(std::invalid_argument(json_global(EMPTY_STD_STRING)));
+		}
+		json_throw(std::out_of_range(json_global(EMPTY_STD_STRING)));
+    }
+
+    JSONNode JSONWorker::NumberNode(const json_char * lexeme, size_t len) json_nothrow {
+	   return ValueNode(lexeme, len);
+    }
+
+    JSONNode JSONWorker::ValueNode(const json_char * text, size_t len) json_nothrow {
+	   return JSONNode(internalJSONNode::newInternal(json_shared_string(), json_shared_string(text, len) STRUCTURAL_ARG(0, 0)));
+    }
 #endif
 
-json_char * JSONWorker::RemoveWhiteSpaceAndCommentsC(const json_string & value_t, bool escapeQuotes) json_nothrow {
+json_char * JSONWorker::RemoveWhiteSpaceAndCommentsC(const json_char * value_t, size_t length, bool escapeQuotes) json_nothrow {
 	size_t len;
-	json_char * result = PRIVATE_REMOVEWHITESPACE(false, value_t, escapeQuotes, len);
+	json_char * result = PRIVATE_REMOVEWHITESPACE(false, value_t, length, escapeQuotes, len);
 	result[len] = JSON_TEXT('\0');
 	return result;
 }
 
-json_string JSONWorker::RemoveWhiteSpaceAndComments(const json_string & value_t, bool escapeQuotes) json_nothrow {
+json_string JSONWorker::RemoveWhiteSpaceAndComments(const json_char * value_t, size_t length, bool escapeQuotes) json_nothrow {
 	json_auto<json_char> s;
     size_t len;
-	s.set(PRIVATE_REMOVEWHITESPACE(false, value_t, escapeQuotes, len)); 
+	s.set(PRIVATE_REMOVEWHITESPACE(false, value_t, length, escapeQuotes, len)); 
 	return json_string(s.ptr, len);
 }
 
 #ifdef JSON_READ_PRIORITY
 /*
- These three functions analyze json_string literals and convert them into std::strings
+ These functions analyze json_string literals and convert them into std::strings
  This includes dealing with special characters and utf characters
  */
-#ifdef JSON_UNICODE
-    inline json_uchar SurrogatePair(const json_uchar hi, const json_uchar lo) json_pure;
-    inline json_uchar SurrogatePair(const json_uchar hi, const json_uchar lo) json_nothrow {
-	   JSON_ASSERT(sizeof(unsigned int) == 4, JSON_TEXT("size of unsigned int is not 32-bit"));
-	   JSON_ASSERT(sizeof(json_uchar) == 4, JSON_TEXT("size of json_char is not 32-bit"));
-	   return (((hi << 10) & 0x1FFC00) + 0x10000) | lo & 0x3FF;
-    }
 
-    void JSONWorker::UTF(const json_char * & pos, json_string & result, const json_char * const end) json_nothrow {
-		JSON_ASSERT_SAFE(((long)end - (long)pos) > 4, JSON_TEXT("UTF will go out of bounds"), return;);
-	   json_uchar first = UTF8(pos, end);
-	   if (json_unlikely((first > 0xD800) && (first < 0xDBFF) &&
-		  (*(pos + 1) == '\\') && (*(pos + 2) == 'u'))){
-			 const json_char * original_pos = pos;  //if the 2nd character is not correct I need to roll back the iterator
-			 pos += 2;
-			 json_uchar second = UTF8(pos, end);
-			 //surrogate pair, not two characters
-			 if (json_unlikely((second > 0xDC00) && (second < 0xDFFF))){
-				result += SurrogatePair(first, second);
-			 } else {
-				pos = original_pos;
-			 }
-	   } else {
-		  result += first;
-	   }
-    }
-#endif
+//the value of every hex digit, anything else is 0, the validator is what keeps those out
+static const unsigned char hexValues[128] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0,
+    0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static inline unsigned int hexValue(json_char ch) json_nothrow {
+    return ((unsigned long)(json_uchar)ch < 128) ? hexValues[(json_uchar)ch] : 0;
+}
+
+//the next backslash, everything before it can be copied over as is
+static inline const json_char * nextEscape(const json_char * p, const json_char * const end) json_nothrow {
+    #ifdef JSON_SIMD
+	   return JSONSimd::FindEscape(p, end);
+    #else
+	   while ((p != end) && (*p != JSON_TEXT('\\'))) ++p;
+	   return p;
+    #endif
+}
 
-json_uchar JSONWorker::UTF8(const json_char * & pos, const json_char * const end) json_nothrow {
-	JSON_ASSERT_SAFE(((long)end - (long)pos) > 4, JSON_TEXT("UTF will go out of bounds"), return JSON_TEXT('\0'););
+/*
+ Adds a code point the way that json_chars hold them.  Wide strings get it
+ as is, or as a surrogate pair when wchar_t is only 16 bits.  Narrow strings
+ get UTF-8, except for the first 256 without JSON_UTF8, which stay a single
+ char the way that they always have, since that is what the writer turns
+ back into \u00XX
+ */
+#ifdef JSON_UTF8
+    #define JSON_SINGLE_CHAR_CODES 0x80
+#else
+    #define JSON_SINGLE_CHAR_CODES 0x100
+#endif
+static void appendCodePoint(json_string & res, unsigned long code) json_nothrow {
     #ifdef JSON_UNICODE
-	   ++pos;
-	   json_uchar temp = Hex(pos) << 8;
-	   ++pos;
-	   return temp | Hex(pos);
+	   if ((sizeof(json_char) == 2) && (code > 0xFFFF)){
+		  code -= 0x10000;
+		  res += (json_char)(0xD800 | (code >> 10));
+		  res += (json_char)(0xDC00 | (code & 0x3FF));
+		  return;
+	   }
+	   res += (json_char)code;
     #else
-	   JSON_ASSERT(*(pos + 1) == JSON_TEXT('0'), JSON_TEXT("wide utf character (hihi)"));
-	   JSON_ASSERT(*(pos + 2) == JSON_TEXT('0'), JSON_TEXT("wide utf character (hilo)"));
-	   pos += 3;
-	   return Hex(pos);
+	   json_char buffer[4];
+	   if (code < JSON_SINGLE_CHAR_CODES){
+		  res += (json_char)code;
+		  return;
+	   } else if (code < 0x800){
+		  buffer[0] = (json_char)(0xC0 | (code >> 6));
+		  buffer[1] = (json_char)(0x80 | (code & 0x3F));
+		  res.append(buffer, 2);
+	   } else if (code < 0x10000){
+		  buffer[0] = (json_char)(0xE0 | (code >> 12));
+		  buffer[1] = (json_char)(0x80 | ((code >> 6) & 0x3F));
+		  buffer[2] = (json_char)(0x80 | (code & 0x3F));
+		  res.append(buffer, 3);
+	   } else {
+		  buffer[0] = (json_char)(0xF0 | (code >> 18));
+		  buffer[1] = (json_char)(0x80 | ((code >> 12) & 0x3F));
+		  buffer[2] = (json_char)(0x80 | ((code >> 6) & 0x3F));
+		  buffer[3] = (json_char)(0x80 | (code & 0x3F));
+		  res.append(buffer, 4);
+	   }
     #endif
 }
 
+//a \u escape, pos is on the u and is left on the last digit, or the last digit of the second half of a surrogate pair
+void JSONWorker::UTF(const json_char * & pos, json_string & result, const json_char * const end) json_nothrow {
+	JSON_ASSERT_SAFE((end - pos) > 4, JSON_TEXT("UTF will go out of bounds"), return;);
+    unsigned long code = CodeUnit(pos);
+    if (json_unlikely((code >= 0xD800) && (code <= 0xDBFF) && ((end - pos) > 6) &&
+				  (*(pos + 1) == JSON_TEXT('\\')) && (*(pos + 2) == JSON_TEXT('u')))){
+	   const json_char * second_pos = pos + 2;
+	   const unsigned long second = CodeUnit(second_pos);
+	   //surrogate pair, not two characters, otherwise the second one is left for next time
+	   if (json_likely((second >= 0xDC00) && (second <= 0xDFFF))){
+		  code = (((code - 0xD800) << 10) | (second - 0xDC00)) + 0x10000;
+		  pos = second_pos;
+	   }
+    }
+    appendCodePoint(result, code);
+}
+
+unsigned long JSONWorker::CodeUnit(const json_char * & pos) json_nothrow {
+    const unsigned long res = (hexValue(pos[1]) << 12) | (hexValue(pos[2]) << 8) | (hexValue(pos[3]) << 4) | hexValue(pos[4]);
+    pos += 4;
+    return res;
+}
 
 json_char JSONWorker::Hex(const json_char * & pos) json_nothrow {
     /*
 	takes the numeric value of the next two characters and convert them
-	\u0058 becomes 0x58
-
-	In case of \u, it's SpecialChar's responsibility to move past the first two chars
-	as this method is also used for \x
+	\x58 becomes 0x58, pos is left on the second one
 	*/
-    //First character
-    json_uchar hi = *pos++ - 48;
-    if (hi > 48){  //A-F don't immediately follow 0-9, so have to pull them down a little
-	   hi -= 39;
-    } else if (hi > 9){  //neither do a-f
-	   hi -= 7;
-    }
-    //second character
-    json_uchar lo = *pos - 48;
-    if (lo > 48){  //A-F don't immediately follow 0-9, so have to pull them down a little
-	   lo -= 39;
-    } else if (lo > 9){  //neither do a-f
-	   lo -= 7;
-    }
-    //combine them
-    return (json_char)((hi << 4) | lo);
+    const unsigned int hi = hexValue(*pos++);
+    return (json_char)((hi << 4) | hexValue(*pos));
 }
 
 #ifndef JSON_STRICT
@@ -351,6 +501,7 @@ void JSONWorker::SpecialChar(const json_char * & pos, const json_char * const en
 	*/
     switch(*pos){
 	   case JSON_TEXT('\1'):  //quote character (altered by RemoveWhiteSpace)
+	   case JSON_TEXT('\"'):  //one that wasn't, like a value that was never searched through
 		  res += JSON_TEXT('\"');
 		  break;
 	   case JSON_TEXT('t'):	//tab character
@@ -378,11 +529,7 @@ void JSONWorker::SpecialChar(const json_char * & pos, const json_char * const en
 		  res += JSON_TEXT('\v');
 		  break;
 	   case JSON_TEXT('u'):	//utf character
-		  #ifdef JSON_UNICODE
-			 UTF(pos, res, end);
-		  #else
-			 res += UTF8(pos, end);
-		  #endif
+		  UTF(pos, res, end);
 		  break;
 	   #ifndef JSON_STRICT
 		  case JSON_TEXT('x'):   //hexidecimal ascii code
@@ -425,137 +572,179 @@ void JSONWorker::SpecialChar(const json_char * & pos, const json_char * const en
 	   }
     }
 
-    json_string JSONWorker::FixString(const json_string & value_t, const internalJSONNode * flag, bool which) json_nothrow {
+    json_string JSONWorker::FixString(const json_char * value_t, size_t len, const internalJSONNode * flag, bool which) json_nothrow {
     #define setflag(x) doflag(flag, which, x)
 #else
-    json_string JSONWorker::FixString(const json_string & value_t, bool & flag) json_nothrow {
+    json_string JSONWorker::FixString(const json_char * value_t, size_t len, bool & flag) json_nothrow {
     #define setflag(x) flag = x
 #endif
 
     //Do things like unescaping
     setflag(false);
+	const json_char * const end = value_t + len;
+    const json_char * p = nextEscape(value_t, end);
+    if (json_likely(p == end)) return json_string(value_t, len);  //most strings don't have anything escaped at all
+
+    setflag(true);
     json_string res;
-    res.reserve(value_t.length());	 //since it goes one character at a time, want to reserve it first so that it doens't have to reallocating
-	const json_char * const end = value_t.data() + value_t.length();
-    for(const json_char * p = value_t.data(); p != end; ++p){
-	   switch (*p){
-		  case JSON_TEXT('\\'):
-			 setflag(true);
-			 SpecialChar(++p, end, res);
-			 break;
-		  default:
-			 res += *p;
-			 break;
-	   }
-    }
+    res.reserve(len);	 //unescaping only ever makes it shorter, so this is the only allocation
+    res.append(value_t, p - value_t);
+    do {
+	   SpecialChar(++p, end, res);  //leaves p on the last character of the escape
+	   if (json_unlikely(p == end)) break;  //a backslash with nothing after it
+	   const json_char * const clean = ++p;
+	   p = nextEscape(clean, end);
+	   res.append(clean, p - clean);  //everything up to the next escape in one go
+    } while (p != end);
 	shrinkString(res);  //because this is actually setting something to be stored, shrink it it need be
 	return res;
 }
 #endif
 
-#ifdef JSON_UNICODE
-    #ifdef JSON_ESCAPE_WRITES
-	   json_string JSONWorker::toSurrogatePair(json_uchar C) json_nothrow {
-		  JSON_ASSERT(sizeof(unsigned int) == 4, JSON_TEXT("size of unsigned int is not 32-bit"));
-		  JSON_ASSERT(sizeof(unsigned short) == 2, JSON_TEXT("size of unsigned short is not 16-bit"));
-		  JSON_ASSERT(sizeof(json_uchar) == 4, JSON_TEXT("json_char is not 32-bit"));
-
-		  //Compute the high surrogate
-		  unsigned short HiSurrogate = 0xD800 | (((unsigned short)((unsigned int)((C >> 16) & 31)) - 1) << 6) | ((unsigned short)C) >> 10;
+#ifdef JSON_ESCAPE_WRITES
+    #define ESCAPED(ch) ch
+#else
+    #define ESCAPED(ch) 0
+#endif
+#define ESCAPED_ROW ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'),\
+				ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u')
+#ifdef JSON_UTF8
+    #define HIGH_ROW 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0  //UTF-8 is written as it is
+#else
+    #define HIGH_ROW ESCAPED_ROW
+#endif
 
-		  //compute the low surrogate
-		  unsigned short LoSurrogate = (unsigned short) (0xDC00 | ((unsigned short)C & 1023));
+/*
+ What each character is written as, 0 for itself, u for \u00XX, otherwise
+ whatever goes after the backslash.  Only quotes and backslashes have to
+ be escaped unless JSON_ESCAPE_WRITES is on, and UTF-8 never is
+ */
+static const unsigned char escapes[256] = {
+    ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'),
+    ESCAPED('b'), ESCAPED('t'), ESCAPED('n'), ESCAPED('u'), ESCAPED('f'), ESCAPED('r'), ESCAPED('u'), ESCAPED('u'),
+    ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'),
+    ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'), ESCAPED('u'),
+    0, 0, '\"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ESCAPED('/'),
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ESCAPED('u'),
+    HIGH_ROW, HIGH_ROW, HIGH_ROW, HIGH_ROW, HIGH_ROW, HIGH_ROW, HIGH_ROW, HIGH_ROW  //everything past ascii
+};
+#undef ESCAPED_ROW
+#undef HIGH_ROW
+
+static inline json_char escapeFor(json_char ch) json_nothrow {
+    #ifdef JSON_UNICODE
+	   if (json_unlikely((unsigned long)(json_uchar)ch > 255)) return ESCAPED(JSON_TEXT('u'));
+    #endif
+    return (json_char)escapes[(json_uchar)ch];
+}
 
-		  json_string res;
-		  res += toUTF8(HiSurrogate);
-		  res += toUTF8(LoSurrogate);
-		  return res;
-	   }
+//the next character that has to be escaped, everything before it is written as is
+static inline const json_char * nextUnsafe(const json_char * p, const json_char * const end) json_nothrow {
+    #ifdef JSON_SIMD
+	   return JSONSimd::FindUnsafe(p, end);
+    #else
+	   while ((p != end) && (escapeFor(*p) == 0)) ++p;
+	   return p;
     #endif
-#endif
+}
+
+#undef ESCAPED
 
 #ifdef JSON_ESCAPE_WRITES
-    json_string JSONWorker::toUTF8(json_uchar p) json_nothrow {
-	   #ifdef JSON_UNICODE
-		  if (json_unlikely(p > 0xFFFF)) return toSurrogatePair(p);
-	   #endif
-	   json_string res(JSON_TEXT("\\u"));
-	   #ifdef JSON_UNICODE
-		  START_MEM_SCOPE
-			 json_uchar hihi = ((p & 0xF000) >> 12) + 48;
-			 if (hihi > 57) hihi += 7; //A-F don't immediately follow 0-9, so have to further adjust those
-			 json_uchar hilo = ((p & 0x0F00) >> 8) + 48;
-			 if (hilo > 57) hilo += 7; //A-F don't immediately follow 0-9, so have to further adjust those
-			 res += hihi;
-			 res += hilo;
-		  END_MEM_SCOPE
-		  json_uchar hi = ((p & 0x00F0) >> 4) + 48;
-	   #else
-		  res += JSON_TEXT("00");
-		  json_uchar hi = (p >> 4) + 48;
-	   #endif
-	   //convert the character to be escaped into two digits between 0 and 15
-	   if (hi > 57) hi += 7; //A-F don't immediately follow 0-9, so have to further adjust those
-	   json_uchar lo = (p & 0x000F) + 48;
-	   if (lo > 57) lo += 7; //A-F don't immediately follow 0-9, so have to further adjust those
-	   res += hi;
-	   res += lo;
-	   return res;
+    //\uXXXX for one 16 bit unit, buffer needs room for 6
+    static inline void escapeUnit(unsigned long unit, json_char * buffer) json_nothrow {
+	   static const json_char hexDigits[] = JSON_TEXT("0123456789ABCDEF");
+	   buffer[0] = JSON_TEXT('\\');
+	   buffer[1] = JSON_TEXT('u');
+	   buffer[2] = hexDigits[(unit >> 12) & 0xF];
+	   buffer[3] = hexDigits[(unit >> 8) & 0xF];
+	   buffer[4] = hexDigits[(unit >> 4) & 0xF];
+	   buffer[5] = hexDigits[unit & 0xF];
     }
 #endif
 
+static void appendEscape(json_char ch, json_string & res) json_nothrow {
+    json_char buffer[12];
+    buffer[0] = JSON_TEXT('\\');
+    buffer[1] = escapeFor(ch);
+    #ifdef JSON_ESCAPE_WRITES
+	   if (buffer[1] == JSON_TEXT('u')){
+		  unsigned long code = (unsigned long)(json_uchar)ch;
+		  #ifdef JSON_UNICODE
+			 if (json_unlikely(code > 0xFFFF)){  //doesn't fit in one \u, so it's written as a surrogate pair
+				code = (code - 0x10000) & 0xFFFFF;
+				escapeUnit(0xD800 | (code >> 10), buffer);
+				escapeUnit(0xDC00 | (code & 0x3FF), buffer + 6);
+				res.append(buffer, 12);
+				return;
+			 }
+		  #endif
+		  escapeUnit(code, buffer);
+		  res.append(buffer, 6);
+		  return;
+	   }
+    #endif
+    res.append(buffer, 2);
+}
+
 void JSONWorker::UnfixString(const json_string & value_t, bool flag, json_string & res) json_nothrow {
     if (!flag){
 		res += value_t;
 		return;
 	}
     //Re-escapes a json_string so that it can be written out into a JSON file
-	const json_char * const end = value_t.data() + value_t.length();
-    for(const json_char * p = value_t.data(); p != end; ++p){
-	   switch(*p){
-		  case JSON_TEXT('\"'):  //quote character
-			 res += JSON_TEXT("\\\"");
-			 break;
-		  case JSON_TEXT('\\'):	//backslash
-			 res += JSON_TEXT("\\\\");
-			 break;
-		  #ifdef JSON_ESCAPE_WRITES
-			 case JSON_TEXT('\t'):	//tab character
-				res += JSON_TEXT("\\t");
-				break;
-			 case JSON_TEXT('\n'):	//newline character
-				res += JSON_TEXT("\\n");
-				break;
-			 case JSON_TEXT('\r'):	//return character
-				res += JSON_TEXT("\\r");
-				break;
-			 case JSON_TEXT('/'):	//forward slash
-				res += JSON_TEXT("\\/");
-				break;
-			 case JSON_TEXT('\b'):	//backspace
-				res += JSON_TEXT("\\b");
-				break;
-			 case JSON_TEXT('\f'):	//formfeed
-				res += JSON_TEXT("\\f");
-				break;
-			 default:
-			 {
-				if (json_unlikely(((json_uchar)(*p) < 32) || ((json_uchar)(*p) > 126))){
-				    res += toUTF8((json_uchar)(*p));
-				} else {
-				    res += *p;
-				}
-			}
-				break;
-		  #else
-			 default:
-				res += *p;
-				break;
-		  #endif
-	   }
+    const json_char * p = value_t.data();
+	const json_char * const end = p + value_t.length();
+    res.reserve(res.length() + value_t.length() + 16);  //enough for a few escapes, so most strings only need this one
+    for(;;){
+	   const json_char * const clean = p;
+	   p = nextUnsafe(p, end);
+	   res.append(clean, p - clean);  //everything up to the next escape in one go
+	   if (p == end) return;
+	   appendEscape(*p++, res);
     }
 }
 
+bool JSONWorker::PointerToken(const json_string & pointer, size_t & pos, json_string & token) json_nothrow {
+	if (json_unlikely(pointer[pos] != JSON_TEXT('/'))) return false;
+	clearString(token);
+	for(++pos; (pos < pointer.length()) && (pointer[pos] != JSON_TEXT('/')); ++pos){
+		if (pointer[pos] == JSON_TEXT('~')){
+			if (json_unlikely(++pos == pointer.length())) return false;
+			switch(pointer[pos]){
+				case JSON_TEXT('0'):
+					token += JSON_TEXT('~');
+					break;
+				case JSON_TEXT('1'):
+					token += JSON_TEXT('/');
+					break;
+				default:
+					return false;
+			}
+		} else {
+			token += pointer[pos];
+		}
+	}
+	return true;
+}
+
+//array indexes are plain decimal, without leading zeros
+bool JSONWorker::PointerIndex(const json_string & token, json_index_t & index) json_nothrow {
+	if (json_unlikely(token.empty() || ((token[0] == JSON_TEXT('0')) && (token.length() != 1)))) return false;
+	index = 0;
+	for(size_t i = 0; i < token.length(); ++i){
+		if (json_unlikely((token[i] < JSON_TEXT('0')) || (token[i] > JSON_TEXT('9')))) return false;
+		const json_index_t next = (index * 10) + (json_index_t)(token[i] - JSON_TEXT('0'));
+		if (json_unlikely(next / 10 != index)) return false;  //overflow
+		index = next;
+	}
+	return true;
+}
+
 #ifdef JSON_READ_PRIORITY
 //Create a childnode
 #ifdef JSON_COMMENTS
@@ -563,7 +752,7 @@ void JSONWorker::UnfixString(const json_string & value_t, bool flag, json_string
 #else
     #define ARRAY_PARAM bool
 #endif
-inline void JSONWorker::NewNode(const internalJSONNode * parent, const json_string & name, const json_string & value, ARRAY_PARAM) json_nothrow {
+inline void JSONWorker::NewNode(const internalJSONNode * parent, const json_shared_string & name, const json_shared_string & value, ARRAY_PARAM STRUCTURAL_PARAM) json_nothrow {
     #ifdef JSON_COMMENTS
 	   JSONNode * child;
 	   START_MEM_SCOPE
@@ -571,7 +760,7 @@ inline void JSONWorker::NewNode(const internalJSONNode * parent, const json_stri
 		  START_MEM_SCOPE
 			 const json_char * runner = ((array) ? value.data() : name.data());
 			 #ifdef JSON_DEBUG
-				const json_char * const end = runner + value.length();
+				const json_char * const end = ((array) ? value.data() + value.length() : name.data() + name.length());
 			#endif
 			 if (json_unlikely(*runner == JSON_TEMP_COMMENT_IDENTIFIER)){  //multiple comments will be consolidated into one
 				size_t count;
@@ -591,9 +780,11 @@ inline void JSONWorker::NewNode(const internalJSONNode * parent, const json_stri
 			 }
 			 internalJSONNode * myinternal;
 			 if (array){
-				myinternal = internalJSONNode::newInternal(name, runner);
+				myinternal = internalJSONNode::newInternal(name, json_shared_string(value, runner - value.data()) STRUCTURAL_ARG(index, entry));
+			 } else if (json_likely(!name.empty())){
+				myinternal = internalJSONNode::newInternal(json_shared_string(name, ++runner - name.data()), value STRUCTURAL_ARG(index, entry));
 			 } else {
-				myinternal = internalJSONNode::newInternal(++runner, value);
+				myinternal = internalJSONNode::newInternal(name, value STRUCTURAL_ARG(index, entry));
 			 }
 			 child = JSONNode::newJSONNode(myinternal);
 		  END_MEM_SCOPE
@@ -602,73 +793,164 @@ inline void JSONWorker::NewNode(const internalJSONNode * parent, const json_stri
 	   const_cast<internalJSONNode*>(parent) -> CHILDREN -> push_back(child);   //attach it to the parent node
     #else
 	if (name.empty()){
-	   	const_cast<internalJSONNode*>(parent) -> CHILDREN -> push_back(JSONNode::newJSONNode(internalJSONNode::newInternal(name, value)));	    //attach it to the parent node
+	   	const_cast<internalJSONNode*>(parent) -> CHILDREN -> push_back(JSONNode::newJSONNode(internalJSONNode::newInternal(name, value STRUCTURAL_ARG(index, entry))));	    //attach it to the parent node
 	} else {
-		const_cast<internalJSONNode*>(parent) -> CHILDREN -> push_back(JSONNode::newJSONNode(internalJSONNode::newInternal(json_string(name.begin() + 1, name.end()), value)));	    //attach it to the parent node
+		const_cast<internalJSONNode*>(parent) -> CHILDREN -> push_back(JSONNode::newJSONNode(internalJSONNode::newInternal(json_shared_string(name, 1), value STRUCTURAL_ARG(index, entry))));	    //attach it to the parent node
 	}
     #endif
 }
 
+#ifdef JSON_STRUCTURAL_INDEX
+	#define IS_OPENING(ch) (((ch) == JSON_TEXT('{')) || ((ch) == JSON_TEXT('[')))
+
+	//Finds the next ch that belongs to this container, nested containers are skipped in one step
+	inline json_index_t JSONWorker::NextIndexed(json_char ch, const JSONStructuralIndex * index, json_index_t entry, const json_index_t last, const json_char * value_t, const size_t base) json_nothrow {
+		for(; entry != last; ++entry){
+			const json_char current = value_t[index -> position(entry) - base];
+			if (json_unlikely(current == ch)) return entry;
+			if (IS_OPENING(current)) entry = index -> match(entry);
+		}
+		return last;
+	}
+
+	//Gives the container enough room for all of its children up front, just have to count the commas
+	inline void JSONWorker::ReserveIndexed(const internalJSONNode * parent, const json_char * value_t, const size_t base) json_nothrow {
+		const JSONStructuralIndex * index = parent -> _index;
+		const json_index_t last = index -> match(parent -> _index_entry);
+		json_index_t count = 1;
+		for(json_index_t entry = NextIndexed(JSON_TEXT(','), index, parent -> _index_entry + 1, last, value_t, base);
+			entry != last;
+			entry = NextIndexed(JSON_TEXT(','), index, entry + 1, last, value_t, base)){
+			++count;
+		}
+		jsonChildren::reserve2(const_cast<internalJSONNode*>(parent) -> CHILDREN, count);
+	}
+
+	//The child's entry in the index, if it's a container that starts exactly where the value does
+	#define CHILD_ENTRY(entry, start)\
+		(((entry != last) && (index -> position(entry) - base == start) && IS_OPENING(text[start])) ? entry : JSONStructuralIndex::npos)
+
+	void JSONWorker::DoIndexedArray(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow {
+		JSONStructuralIndex * index = parent -> _index;
+		const json_index_t last = index -> match(parent -> _index_entry);
+		const size_t base = index -> position(parent -> _index_entry);
+		const json_char * const text = value_t.data();
+		ReserveIndexed(parent, text, base);
+
+		const json_shared_string noname;
+		size_t starting = 1;  //ignore the [
+		for(json_index_t entry = parent -> _index_entry + 1;; ++entry){
+			const json_index_t child = CHILD_ENTRY(entry, starting);
+			const json_index_t ending = NextIndexed(JSON_TEXT(','), index, entry, last, text, base);
+			JSON_ASSERT_SAFE(NextIndexed(JSON_TEXT(':'), index, entry, ending, text, base) == ending, JSON_TEXT("Key/Value pairs are not allowed in arrays"), parent -> Nullify(); return;);
+			const size_t value_ending = index -> position(ending) - base;
+			NewNode(parent, noname, json_shared_string(value_t, starting, value_ending - starting), true STRUCTURAL_ARG(index, child));
+			if (ending == last) return;
+			starting = value_ending + 1;
+			entry = ending;
+		}
+	}
+
+	void JSONWorker::DoIndexedNode(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow {
+		JSONStructuralIndex * index = parent -> _index;
+		const json_index_t last = index -> match(parent -> _index_entry);
+		const size_t base = index -> position(parent -> _index_entry);
+		const json_char * const text = value_t.data();
+		ReserveIndexed(parent, text, base);
+
+		size_t name_starting = 1;  //ignore the {
+		for(json_index_t entry = parent -> _index_entry + 1;; ++entry){
+			const json_index_t colon = NextIndexed(JSON_TEXT(':'), index, entry, last, text, base);
+			if (json_unlikely(colon == last)){
+				JSON_FAIL_SAFE(JSON_TEXT("Missing :"), parent -> Nullify(););
+				return;
+			}
+			const size_t name_ending = index -> position(colon) - base;
+			const json_shared_string name(value_t, name_starting, (name_ending > name_starting) ? name_ending - 1 - name_starting : 0);  //pull the name out
+			const json_index_t child = CHILD_ENTRY(colon + 1, name_ending + 1);
+			const json_index_t ending = NextIndexed(JSON_TEXT(','), index, colon + 1, last, text, base);
+			const size_t value_ending = index -> position(ending) - base;
+			NewNode(parent, name, json_shared_string(value_t, name_ending + 1, value_ending - name_ending - 1), false STRUCTURAL_ARG(index, child));
+			if (ending == last) return;
+			name_starting = value_ending + 1;
+			entry = ending;
+		}
+	}
+#endif
+
 //Create a subarray
-void JSONWorker::DoArray(const internalJSONNode * parent, const json_string & value_t) json_nothrow {
+void JSONWorker::DoArray(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow {
 	//This takes an array and creates nodes out of them
 	JSON_ASSERT(!value_t.empty(), JSON_TEXT("DoArray is empty"));
 	JSON_ASSERT_SAFE(value_t[0] == JSON_TEXT('['), JSON_TEXT("DoArray is not an array"), parent -> Nullify(); return;);
 	if (json_unlikely(value_t.length() <= 2)) return;  // just a [] (blank array)
+	#ifdef JSON_STRUCTURAL_INDEX
+		if (parent -> _index != 0){
+			DoIndexedArray(parent, value_t);
+			return;
+		}
+	#endif
 	
+	//FindNextRelevant needs a real string to look through, the children are still sliced out of the shared one
+	const json_string text(value_t.data(), value_t.length());
+	const json_shared_string noname;
 	#ifdef JSON_SAFE
 		json_string newValue;  //share this so it has a reserved buffer
 	#endif
 	size_t starting = 1;  //ignore the [
 	
 	//Not sure what's in the array, so we have to use commas
-	for(size_t ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), value_t, 1);
+	for(size_t ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), text, 1);
 		ending != json_string::npos;
-		ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), value_t, starting)){
+		ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), text, starting)){
 		
 		#ifdef JSON_SAFE
-			newValue.assign(value_t.begin() + starting, value_t.begin() + ending);
+			newValue.assign(text.begin() + starting, text.begin() + ending);
 			JSON_ASSERT_SAFE(FIND_NEXT_RELEVANT(JSON_TEXT(':'), newValue, 0) == json_string::npos, JSON_TEXT("Key/Value pairs are not allowed in arrays"), parent -> Nullify(); return;);
-			NewNode(parent, json_global(EMPTY_JSON_STRING), newValue, true);
-		#else
-			NewNode(parent, json_global(EMPTY_JSON_STRING), json_string(value_t.begin() + starting, value_t.begin() + ending), true);
 		#endif
+		NewNode(parent, noname, json_shared_string(value_t, starting, ending - starting), true STRUCTURAL_ARG(0, 0));
 		starting = ending + 1;
 	}
 	//since the last one will not find the comma, we have to add it here, but ignore the final ]
 	
 	#ifdef JSON_SAFE
-		newValue.assign(value_t.begin() + starting, value_t.end() - 1);
+		newValue.assign(text.begin() + starting, text.end() - 1);
 		JSON_ASSERT_SAFE(FIND_NEXT_RELEVANT(JSON_TEXT(':'), newValue, 0) == json_string::npos, JSON_TEXT("Key/Value pairs are not allowed in arrays"), parent -> Nullify(); return;);
-		NewNode(parent, json_global(EMPTY_JSON_STRING), newValue, true);
-	#else
-		NewNode(parent, json_global(EMPTY_JSON_STRING), json_string(value_t.begin() + starting, value_t.end() - 1), true);
 	#endif
+	NewNode(parent, noname, json_shared_string(value_t, starting, text.length() - 1 - starting), true STRUCTURAL_ARG(0, 0));
 }
 
 
 //Create all child nodes
-void JSONWorker::DoNode(const internalJSONNode * parent, const json_string & value_t) json_nothrow {	
+void JSONWorker::DoNode(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow {	
 	//This take a node and creates its members and such
 	JSON_ASSERT(!value_t.empty(), JSON_TEXT("DoNode is empty"));
 	JSON_ASSERT_SAFE(value_t[0] == JSON_TEXT('{'), JSON_TEXT("DoNode is not an node"), parent -> Nullify(); return;);
 	if (json_unlikely(value_t.length() <= 2)) return;  // just a {} (blank node)
+	#ifdef JSON_STRUCTURAL_INDEX
+		if (parent -> _index != 0){
+			DoIndexedNode(parent, value_t);
+			return;
+		}
+	#endif
 	
-	size_t name_ending = FIND_NEXT_RELEVANT(JSON_TEXT(':'), value_t, 1);  //find where the name ends
+	//FindNextRelevant needs a real string to look through, the children are still sliced out of the shared one
+	const json_string text(value_t.data(), value_t.length());
+	size_t name_ending = FIND_NEXT_RELEVANT(JSON_TEXT(':'), text, 1);  //find where the name ends
 	JSON_ASSERT_SAFE(name_ending != json_string::npos, JSON_TEXT("Missing :"), parent -> Nullify(); return;);
-	json_string name(value_t.begin() + 1, value_t.begin() + name_ending - 1);	  //pull the name out
-	for (size_t value_ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), value_t, name_ending),  //find the end of the value
+	json_shared_string name(value_t, 1, (name_ending > 1) ? name_ending - 2 : 0);	  //pull the name out
+	for (size_t value_ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), text, name_ending),  //find the end of the value
 		 name_starting = 1;  //ignore the {
 		 value_ending != json_string::npos;
-		 value_ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), value_t, name_ending)){
+		 value_ending = FIND_NEXT_RELEVANT(JSON_TEXT(','), text, name_ending)){
 		
-		NewNode(parent, name, json_string(value_t.begin() + name_ending + 1, value_t.begin() + value_ending), false);
+		NewNode(parent, name, json_shared_string(value_t, name_ending + 1, value_ending - name_ending - 1), false STRUCTURAL_ARG(0, 0));
 		name_starting = value_ending + 1;
-		name_ending = FIND_NEXT_RELEVANT(JSON_TEXT(':'), value_t, name_starting);
+		name_ending = FIND_NEXT_RELEVANT(JSON_TEXT(':'), text, name_starting);
 		JSON_ASSERT_SAFE(name_ending != json_string::npos, JSON_TEXT("Missing :"), parent -> Nullify(); return;);
-		name.assign(value_t.begin() + name_starting, value_t.begin() + name_ending - 1);
+		name.assign(value_t, name_starting, (name_ending > name_starting) ? name_ending - 1 - name_starting : 0);
 	}
 	//since the last one will not find the comma, we have to add it here
-	NewNode(parent, name, json_string(value_t.begin() + name_ending + 1, value_t.end() - 1), false);
+	NewNode(parent, name, json_shared_string(value_t, name_ending + 1, text.length() - name_ending - 2), false STRUCTURAL_ARG(0, 0));
 }
 #endif
@@ -6,28 +6,64 @@
 
 class JSONWorker {
 public:
-    static json_string RemoveWhiteSpaceAndComments(const json_string & value_t, bool escapeQuotes) json_nothrow json_read_priority;
-	static json_char * RemoveWhiteSpaceAndCommentsC(const json_string & value_t, bool escapeQuotes) json_nothrow json_read_priority;
+    static json_string RemoveWhiteSpaceAndComments(const json_char * value_t, size_t length, bool escapeQuotes) json_nothrow json_read_priority;
+	static inline json_string RemoveWhiteSpaceAndComments(const json_string & value_t, bool escapeQuotes) json_nothrow {
+		return RemoveWhiteSpaceAndComments(value_t.data(), value_t.length(), escapeQuotes);
+	}
+	static json_char * RemoveWhiteSpaceAndCommentsC(const json_char * value_t, size_t length, bool escapeQuotes) json_nothrow json_read_priority;
+	static inline json_char * RemoveWhiteSpaceAndCommentsC(const json_string & value_t, bool escapeQuotes) json_nothrow {
+		return RemoveWhiteSpaceAndCommentsC(value_t.data(), value_t.length(), escapeQuotes);
+	}
 
     #ifdef JSON_READ_PRIORITY
-	   static JSONNode parse(const json_string & json) json_throws(std::invalid_argument) json_read_priority;
-	   static JSONNode parse_unformatted(const json_string & json) json_throws(std::invalid_argument) json_read_priority;
+	   static JSONNode parse(const json_char * json, size_t length) json_throws(std::invalid_argument) json_read_priority;
+	   static inline JSONNode parse(const json_string & json) json_throws(std::invalid_argument) {
+		  return parse(json.data(), json.length());
+	   }
+	   static JSONNode parse_unformatted(const json_char * json, size_t length) json_throws(std::invalid_argument) json_read_priority;
+	   static inline JSONNode parse_unformatted(const json_string & json) json_throws(std::invalid_argument) {
+		  return parse_unformatted(json.data(), json.length());
+	   }
 
-		static JSONNode _parse_unformatted(const json_char * json, const json_char * const end) json_throws(std::invalid_argument) json_read_priority;
+	   static JSONNode parse_insitu(json_char * buf, size_t len) json_throws(std::invalid_argument) json_read_priority;
+	   static JSONNode parse_scratch(json_char * buf, size_t len) json_throws(std::invalid_argument) json_read_priority;
 
-		static json_char * RemoveWhiteSpace(const json_string & value_t, size_t & len, bool escapeQuotes) json_nothrow json_read_priority;
+	   //pos is where in the pointer to start, the text doesn't have to have its white space removed
+	   static JSONNode extract(const json_char * json, size_t length, const json_string & pointer, size_t pos) json_throws(std::logic_error) json_read_priority;
 
-	   static void DoArray(const internalJSONNode * parent, const json_string & value_t) json_nothrow json_read_priority;
-	   static void DoNode(const internalJSONNode * parent, const json_string & value_t) json_nothrow json_read_priority;
+	   //a number node that keeps the text it was read from, so it's written back exactly the way it was
+	   static JSONNode NumberNode(const json_char * lexeme, size_t len) json_nothrow json_read_priority;
+	   //any value that isn't an object or an array, from text that's had its white space removed
+	   static JSONNode ValueNode(const json_char * text, size_t len) json_nothrow json_read_priority;
+
+		static JSONNode _parse_unformatted(const json_char * json, const json_char * const end, bool insitu = false) json_throws(std::invalid_argument) json_read_priority;
+
+		static json_char * RemoveWhiteSpace(const json_char * value_t, size_t length, size_t & len, bool escapeQuotes) json_nothrow json_read_priority;
+		static inline json_char * RemoveWhiteSpace(const json_string & value_t, size_t & len, bool escapeQuotes) json_nothrow {
+			return RemoveWhiteSpace(value_t.data(), value_t.length(), len, escapeQuotes);
+		}
+
+	   static void DoArray(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow json_read_priority;
+	   static void DoNode(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow json_read_priority;
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  static void DoIndexedArray(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow json_read_priority;
+		  static void DoIndexedNode(const internalJSONNode * parent, const json_shared_string & value_t) json_nothrow json_read_priority;
+	   #endif
 
 	   #ifdef JSON_LESS_MEMORY
 		  #define NAME_ENCODED this, true
 		  #define STRING_ENCODED this, false
-		  static json_string FixString(const json_string & value_t, const internalJSONNode * flag, bool which) json_nothrow json_read_priority;
+		  static json_string FixString(const json_char * value_t, size_t len, const internalJSONNode * flag, bool which) json_nothrow json_read_priority;
+		  static inline json_string FixString(const json_string & value_t, const internalJSONNode * flag, bool which) json_nothrow {
+			 return FixString(value_t.data(), value_t.length(), flag, which);
+		  }
 	   #else
 		  #define NAME_ENCODED _name_encoded
 		  #define STRING_ENCODED _string_encoded
-		  static json_string FixString(const json_string & value_t, bool & flag) json_nothrow json_read_priority;
+		  static json_string FixString(const json_char * value_t, size_t len, bool & flag) json_nothrow json_read_priority;
+		  static inline json_string FixString(const json_string & value_t, bool & flag) json_nothrow {
+			 return FixString(value_t.data(), value_t.length(), flag);
+		  }
 	   #endif
     #endif
 
@@ -40,26 +76,27 @@ public:
 		#endif
     #endif
     static void UnfixString(const json_string & value_t, bool flag, json_string & res) json_nothrow;
+
+    //JSON pointers, pos is on a / and is left on the next one, false if a ~ isn't followed by 0 or 1
+    static bool PointerToken(const json_string & pointer, size_t & pos, json_string & token) json_nothrow;
+    static bool PointerIndex(const json_string & token, json_index_t & index) json_nothrow;
 JSON_PRIVATE
     #ifdef JSON_READ_PRIORITY
 	   static json_char Hex(const json_char * & pos) json_nothrow;
-	   static json_uchar UTF8(const json_char * & pos, const json_char * const end) json_nothrow;
-    #endif
-    #ifdef JSON_ESCAPE_WRITES
-	   static json_string toUTF8(json_uchar p) json_nothrow;
-    #endif
-    #ifdef JSON_UNICODE
+	   static unsigned long CodeUnit(const json_char * & pos) json_nothrow;
 	   static void UTF(const json_char * & pos, json_string & result, const json_char * const end) json_nothrow;
-	   #ifdef JSON_ESCAPE_WRITES
-		  static json_string toSurrogatePair(json_uchar pos) json_nothrow;
-	   #endif
-    #endif
-    #ifdef JSON_READ_PRIORITY
 	   static void SpecialChar(const json_char * & pos, const json_char * const end, json_string & res) json_nothrow;
-	   static void NewNode(const internalJSONNode * parent, const json_string & name, const json_string & value, bool array) json_nothrow;
+	   static void NewNode(const internalJSONNode * parent, const json_shared_string & name, const json_shared_string & value, bool array STRUCTURAL_PARAM) json_nothrow;
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  static json_index_t NextIndexed(json_char ch, const JSONStructuralIndex * index, json_index_t entry, const json_index_t last, const json_char * value_t, const size_t base) json_nothrow;
+		  static void ReserveIndexed(const internalJSONNode * parent, const json_char * value_t, const size_t base) json_nothrow;
+	   #endif
     #endif
 private:
     JSONWorker(void);
+    friend class JSONDocument;
+    template<class Handler> friend class JSONSax;
+    friend class JSONReader;
 };
 
 #endif
@@ -179,16 +179,23 @@ void internalJSONNode::WriteChildren(unsigned int indent, json_string & output)
 #endif
 
 void internalJSONNode::DumpRawString(json_string & output) const json_nothrow {
+	//strings and containers keep their raw text in the shared document, literals have their own copy
+	#ifdef JSON_READ_PRIORITY
+		const json_char * start = _unparsed.empty() ? _string.data() : _unparsed.data();
+		const json_char * const end = start + (_unparsed.empty() ? _string.length() : _unparsed.length());
+	#else
+		const json_char * start = _string.data();
+		const json_char * const end = start + _string.length();
+	#endif
 	//first remove the \1 characters
 	if (used_ascii_one){  //if it hasn't been used yet, don't bother checking
-		json_string result(_string.begin(), _string.end());
-		for(json_string::iterator beg = result.begin(), en = result.end(); beg != en; ++beg){
+		const size_t before = output.length();
+		output.append(start, end);
+		for(json_string::iterator beg = output.begin() + before, en = output.end(); beg != en; ++beg){
 			if (*beg == JSON_TEXT('\1')) *beg = JSON_TEXT('\"');
 		}
-		output += result;
-		return;
 	} else {
-		output.append(_string.begin(), _string.end());
+		output.append(start, end);
 	}
 }
 
@@ -229,6 +236,10 @@ void internalJSONNode::Write(unsigned int indent, bool arrayChild, json_string &
             output += JSON_TEXT("]");
 			return;
 	   case JSON_NUMBER:   //write out a literal, without quotes
+		  if (_string.empty()){  //it was set rather than parsed, so it's formatted right into the output
+			 appendNumber(output);
+			 return;
+		  }
 	   case JSON_NULL:
 	   case JSON_BOOL:
             output.append(_string.begin(), _string.end());
@@ -8,9 +8,7 @@
 #endif
 #include "JSONSharedString.h"
 #include <cstdio>
-#ifdef JSON_STRICT
-    #include <cmath>
-#endif
+#include "JSONFloat.h"
 template <unsigned int GETLENSIZE>
 struct getLenSize{
     char tmp[GETLENSIZE == 16];  // compile time assertion
@@ -42,109 +40,113 @@ static inline bool _floatsAreEqual(const json_number & one, const json_number &
     return (one > two) ? (one - two) < JSON_FLOAT_THRESHHOLD : (one - two) > -JSON_FLOAT_THRESHHOLD;
 }
 
-#ifdef JSON_LESS_MEMORY
-    #define num_str_result s.ptr
-#endif
-
 class NumberToString {
 public:
     template<typename T>
     static json_string _itoa(T val) json_nothrow {
-	   #ifdef JSON_LESS_MEMORY
-		  json_auto<json_char> s(getLenSize<sizeof(T)>::GETLEN);
-	   #else
-		  json_char num_str_result[getLenSize<sizeof(T)>::GETLEN];
-	   #endif
-	   num_str_result[getLenSize<sizeof(T)>::GETLEN - 1] = JSON_TEXT('\0'); //null terminator
-	   json_char * runner = &num_str_result[getLenSize<sizeof(T)>::GETLEN - 2];
-	   bool negative;
-
-	   START_MEM_SCOPE
-	   long value = (long)val;
-	   //first thing, check if it's negative, if so, make it positive
-	   if (value < 0){
-		  value = -value;
-		  negative = true;
-	   } else {
-		  negative = false;
-	   }
+	   json_char buffer[getLenSize<sizeof(T)>::GETLEN];
+	   return json_string(buffer, _itoa<T>(val, buffer) - buffer);
+    }
 
-	   //create the string
-	   do {
-		  *runner-- = (json_char)(value % 10) + JSON_TEXT('0');
-	   } while(value /= 10);
-	   END_MEM_SCOPE
+    template<typename T>
+    static json_string _uitoa(T val) json_nothrow {
+	   json_char buffer[getLenSize<sizeof(T)>::GETLEN];
+	   return json_string(buffer, _uitoa<T>(val, buffer) - buffer);
+    }
 
-	   //if it's negative, add the negation
-	   if (negative){
-		  *runner = JSON_TEXT('-');
-		  return json_string(runner);
+    //appends val onto out without making a string of its own first
+    template<typename T>
+    static void _itoa(T val, json_string & out) json_nothrow {
+	   json_char buffer[getLenSize<sizeof(T)>::GETLEN];
+	   out.append(buffer, _itoa<T>(val, buffer) - buffer);
+    }
+
+    template<typename T>
+    static void _uitoa(T val, json_string & out) json_nothrow {
+	   json_char buffer[getLenSize<sizeof(T)>::GETLEN];
+	   out.append(buffer, _uitoa<T>(val, buffer) - buffer);
+    }
+
+    //writes val at out, which needs getLenSize<sizeof(T)>::GETLEN room, and returns the end of it
+    template<typename T>
+    static json_char * _itoa(T val, json_char * out) json_nothrow {
+	   unsigned long long magnitude = (unsigned long long)val;
+	   if (val < 0){
+		  *out++ = JSON_TEXT('-');
+		  magnitude = 0ULL - magnitude;  //right for the most negative value too, where -val isn't
 	   }
-	   return json_string(runner + 1);
+	   out += digitCount(magnitude);
+	   writeDigits(magnitude, out);
+	   return out;
     }
 
     template<typename T>
-    static json_string _uitoa(T val) json_nothrow {
-	   #ifdef JSON_LESS_MEMORY
-		  json_auto<json_char> s(getLenSize<sizeof(T)>::GETLEN);
-	   #else
-		  json_char num_str_result[getLenSize<sizeof(T)>::GETLEN];
-	   #endif
-	   num_str_result[getLenSize<sizeof(T)>::GETLEN - 1] = JSON_TEXT('\0'); //null terminator
-	   json_char * runner = &num_str_result[getLenSize<sizeof(T)>::GETLEN - 2];
-
-	   //create the string
-	   START_MEM_SCOPE
-		  unsigned long value = (unsigned long)val;
-		  do {
-			 *runner-- = (json_char)(value % 10) + JSON_TEXT('0');
-		  } while(value /= 10);
-	   END_MEM_SCOPE
-
-	   return json_string(runner + 1);
+    static json_char * _uitoa(T val, json_char * out) json_nothrow {
+	   const unsigned long long magnitude = (unsigned long long)val;
+	   out += digitCount(magnitude);
+	   writeDigits(magnitude, out);
+	   return out;
+    }
+
+    //how many digits val has, a compare for each one instead of a divide
+    static inline unsigned int digitCount(unsigned long long val) json_nothrow {
+	   unsigned int count = 1;
+	   for(;;){
+		  if (json_likely(val < 10)) return count;
+		  if (val < 100) return count + 1;
+		  if (val < 1000) return count + 2;
+		  if (val < 10000) return count + 3;
+		  val /= 10000;
+		  count += 4;
+	   }
+    }
+
+    //fills in the digits of val backwards from end, two at a time
+    static inline void writeDigits(unsigned long long val, json_char * end) json_nothrow {
+	   const char * const pairs = digitPairs();
+	   while (val >= 100){
+		  const unsigned int pair = (unsigned int)(val % 100) * 2;
+		  val /= 100;
+		  *--end = (json_char)pairs[pair + 1];
+		  *--end = (json_char)pairs[pair];
+	   }
+	   if (val >= 10){
+		  const unsigned int pair = (unsigned int)val * 2;
+		  *--end = (json_char)pairs[pair + 1];
+		  *--end = (json_char)pairs[pair];
+	   } else {
+		  *--end = (json_char)(JSON_TEXT('0') + val);
+	   }
     }
 
-    #define EXTRA_LONG long
-    #define FLOAT_STRING "%Lf"
-    #define LFLOAT_STRING L"%Lf"
+    //"00" through "99", one of these for each divide by 100
+    static inline const char * digitPairs(void) json_nothrow {
+	   static const char pairs[201] =
+		  "0001020304050607080910111213141516171819"
+		  "2021222324252627282930313233343536373839"
+		  "4041424344454647484950515253545556575859"
+		  "6061626364656667686970717273747576777879"
+		  "8081828384858687888990919293949596979899";
+	   return pairs;
+    }
 
     static json_string _ftoa(json_number value) json_nothrow {
-			//ScopeCoverage(_ftoa_coverage, 6);
-		  if (json_unlikely(value >= 0.0 && _floatsAreEqual(value, (json_number)((unsigned EXTRA_LONG long)value)))){
-			 return _uitoa<unsigned EXTRA_LONG long>((unsigned EXTRA_LONG long)value);
-		  } else
-		  if (json_unlikely(_floatsAreEqual(value, (json_number)((long EXTRA_LONG)value)))){
-			 return _itoa<long EXTRA_LONG>((long EXTRA_LONG)value);
-		  }
+	   json_string res;
+	   _ftoa<json_number>(value, res);
+	   return res;
+    }
 
-	   #ifdef JSON_LESS_MEMORY
-		  json_auto<json_char> s(64);
-	   #else
-		  json_char num_str_result[64];
-	   #endif
-	   #ifdef JSON_UNICODE
-		  std::swprintf(num_str_result, 63, LFLOAT_STRING, (EXTRA_LONG double)value);
-	   #else
-		  //Thanks to Salvor Hardin for this Visual C++ fix
-		  #ifdef _MSC_VER
-			 _snprintf_s(num_str_result, 63, 63, FLOAT_STRING, (EXTRA_LONG double)value); //yes, 63 appears twice using _snprintf_s()
-		  #else
-			 snprintf(num_str_result, 63, FLOAT_STRING, (EXTRA_LONG double)value);
-		  #endif
-	   #endif
-	   //strip the trailing zeros
-	   for(json_char * pos = &num_str_result[0]; *pos; ++pos){
-		  if (json_unlikely(*pos == '.')){  //only care about after the decimal
-			 for(json_char * runner = pos + 1; *runner; ++runner){
-				 if (json_likely(*runner != JSON_TEXT('0'))){
-					 pos = runner + 1;  //have to go to the end 1.0001
-				 }
-			 }
-			 *pos = JSON_TEXT('\0');
-			 break;
-		  }
+    //appends the value onto out, with as few digits as it takes to read it back as the same T
+    template<typename T>
+    static void _ftoa(T value, json_string & out) json_nothrow {
+	   //whole numbers are quicker as integers
+	   if (json_likely((value > (T)std::numeric_limits<long long>::min()) &&
+				    (value < (T)std::numeric_limits<long long>::max()) &&
+				    (value == (T)((long long)value)))){
+		  _itoa<long long>((long long)value, out);
+		  return;
 	   }
-	   return json_string(num_str_result);
+	   JSONFloat::write(value, out);
     }
 
     #if defined(JSON_SAFE) || defined(JSON_DEBUG)
@@ -346,11 +348,12 @@ public:
     #ifdef JSON_STRICT
 	   //much faster because no octal or hex support
 	   static json_number _atof (const json_char * num){
-		  json_number sign = (json_number)1.0;
+		  const json_char * const lexeme = num;
+		  bool negative = false;
 
 		  //sign
 		  if (*num==JSON_TEXT('-')){
-			 sign = -1.0;
+			 negative = true;
 			 ++num;
 		  } else {
 		  }
@@ -372,13 +375,16 @@ public:
 		   JSON_ASSERT_SAFE(*num != JSON_TEXT('0'), JSON_TEXT("multiple leading zeros"), return std::numeric_limits<json_number>::signaling_NaN(); );
 
 		  // Number
-		   json_number n = (json_number)0.0;
+		  unsigned long long digits = 0;
+		  int count = 0;
+		  long exponent = 0;
+		  bool truncated = false;
 		  if (json_likely(*num >= JSON_TEXT('1') && *num <= JSON_TEXT('9'))){
 			  #if defined(JSON_SAFE) || defined(JSON_DEBUG)
 				  _leadingdigits = true;
 			  #endif
 			 do {
-				n = (n * 10.0) + (*num++ - JSON_TEXT('0'));
+				JSONFloat::digit(digits, count, exponent, truncated, (unsigned int)(*num++ - JSON_TEXT('0')), false);
 			 } while (*num >= JSON_TEXT('0') && *num <= JSON_TEXT('9'));
 		  } else {
 			  JSON_ASSERT_SAFE(
@@ -390,16 +396,14 @@ public:
 		  }
 
 		  // Fractional part
-		  json_number scale = (json_number)0.0;
 		  if (*num == JSON_TEXT('.')) {
 			  JSON_ASSERT_SAFE(_leadingzeros || _leadingdigits, JSON_TEXT("period without leading anything"), return std::numeric_limits<json_number>::signaling_NaN(); );
 			 ++num;
 			  for(; *num >= JSON_TEXT('0') && *num <= JSON_TEXT('9');){
-				n = (n * 10.0) + (*num++ - JSON_TEXT('0'));
-				--scale;
+				JSONFloat::digit(digits, count, exponent, truncated, (unsigned int)(*num++ - JSON_TEXT('0')), true);
 			  };
 		  } else {
-			  JSON_ASSERT_SAFE(!_leadingzeros || n == 0, JSON_TEXT("leading zero on an int"), return std::numeric_limits<json_number>::signaling_NaN(); );
+			  JSON_ASSERT_SAFE(!_leadingzeros || digits == 0, JSON_TEXT("leading zero on an int"), return std::numeric_limits<json_number>::signaling_NaN(); );
 			  JSON_ASSERT_SAFE(
 							   (*num) == JSON_TEXT('e') ||	 //0Exxx
 							   (*num) == JSON_TEXT('E') ||	 //0exxx
@@ -408,7 +412,7 @@ public:
 		  }
 
 		  // Exponent
-		  int subscale = 0, signsubscale = 1;
+		  long subscale = 0, signsubscale = 1;
 		  if (json_unlikely(*num == JSON_TEXT('e') || *num == JSON_TEXT('E'))){
 			 ++num;
 			 switch(*num){
@@ -425,14 +429,54 @@ public:
 			 }
 			 JSON_ASSERT_SAFE(*num != JSON_TEXT('\0'), JSON_TEXT("no exponent for scientific notation"), return std::numeric_limits<json_number>::signaling_NaN(); );
 			 while (*num >= JSON_TEXT('0') && *num <= JSON_TEXT('9')){
-				subscale=(subscale * 10) + (*num++ - JSON_TEXT('0'));
+				if (subscale < 100000){  //already zero or infinity, but don't overflow
+				    subscale=(subscale * 10) + (*num - JSON_TEXT('0'));
+				}
+				++num;
 			 }
 		  }
 
 		  JSON_ASSERT_SAFE(*num == JSON_TEXT('\0'), JSON_TEXT("done with number, not at terminator"), return std::numeric_limits<json_number>::signaling_NaN(); );
-		  return sign * n * pow((json_number)10.0, scale + subscale * signsubscale);	// number = +/- number.fraction * 10^+/- exponent
+		  return JSONFloat::compute(negative, digits, exponent + subscale * signsubscale, truncated, lexeme, num - lexeme);	// number = +/- digits * 10^+/- exponent
 	   }
     #endif
+
+    //for a number lexeme that is somewhere in the middle of some text, so it isn't terminated
+    static inline json_number _atof(const json_char * num, size_t len) json_nothrow {
+	   return JSONFloat::parse(num, len);
+    }
+
+    //a whole number with no fraction or exponent that fits in 64 bits, false for anything that needs _atof instead
+    static bool _atoi(const json_char * num, size_t len, unsigned long long & magnitude, bool & negative) json_nothrow {
+	   const json_char * const end = num + len;
+	   negative = false;
+	   if (json_likely(num != end)){
+		  if (*num == JSON_TEXT('-')){
+			 negative = true;
+			 ++num;
+		  }
+		  #ifndef JSON_STRICT
+			 else if (*num == JSON_TEXT('+')){
+				++num;
+			 }
+		  #endif
+	   }
+	   if (json_unlikely(num == end)) return false;
+	   if (*num == JSON_TEXT('0') && (end - num) > 1) return false;  //octal, hex, 0.5 and leading zeros are all _atof's
+
+	   magnitude = 0;
+	   for(; num != end; ++num){
+		  if (json_unlikely(*num < JSON_TEXT('0') || *num > JSON_TEXT('9'))) return false;
+		  const unsigned int digit = (unsigned int)(*num - JSON_TEXT('0'));
+		  if (json_unlikely(magnitude > (~0ULL - digit) / 10)) return false;  //too big, a json_number will have to do
+		  magnitude = magnitude * 10 + digit;
+	   }
+	   if (negative){
+		  if (json_unlikely(magnitude == 0)) return false;  //-0 is a float
+		  if (json_unlikely(magnitude > (1ULL << 63))) return false;
+	   }
+	   return true;
+    }
 };
 
 #endif
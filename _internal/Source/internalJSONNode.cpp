@@ -3,13 +3,16 @@
 #include "JSONNode.h"  //To fill in the foreward declaration
 #include "JSONWorker.h"  //For fetching and parsing and such
 #include "JSONGlobals.h"
+#include "JSONThreads.h"  //For preparse_parallel
 
 internalJSONNode::internalJSONNode(const internalJSONNode & orig) json_nothrow :
-    _type(orig._type), _name(orig._name), _name_encoded(orig._name_encoded),
+    _type(orig._type), _numtype(orig._numtype), _name(orig._name), _name_encoded(orig._name_encoded),
     _string(orig._string), _string_encoded(orig._string_encoded), _value(orig._value)
     initializeMutex(0)
     initializeRefCount(1)
     initializeFetch(orig.fetched)
+    initializeIndex(orig._index ? orig._index -> incRef() : 0, orig._index_entry)
+    initializeUnparsed(orig._unparsed)
     initializeComment(orig._comment)
     initializeChildren(0){
 
@@ -37,10 +40,12 @@ internalJSONNode::internalJSONNode(const internalJSONNode & orig) json_nothrow :
 
 //this one is specialized because the root can only be array or node
 #ifdef JSON_READ_PRIORITY /*-> JSON_READ_PRIORITY */
-internalJSONNode::internalJSONNode(const json_string & unparsed) json_nothrow : _type(), _name(),_name_encoded(false), _string(unparsed), _string_encoded(), _value()
+internalJSONNode::internalJSONNode(const json_shared_string & unparsed) json_nothrow : _type(), _numtype(number_float), _name(),_name_encoded(false), _string(), _string_encoded(), _value()
     initializeMutex(0)
     initializeRefCount(1)
     initializeFetch(false)
+    initializeIndex(0, 0)
+    initializeUnparsed(unparsed)
     initializeComment(json_global(EMPTY_JSON_STRING))
     initializeChildren(0){
 
@@ -75,10 +80,12 @@ internalJSONNode::internalJSONNode(const json_string & unparsed) json_nothrow :
 	   case JSON_TEXT(x)
 #endif
 
-internalJSONNode::internalJSONNode(const json_string & name_t, const json_string & value_t) json_nothrow : _type(), _name_encoded(), _name(JSONWorker::FixString(name_t, NAME_ENCODED)), _string(), _string_encoded(), _value()
+internalJSONNode::internalJSONNode(const json_shared_string & name_t, const json_shared_string & value_t STRUCTURAL_PARAM) json_nothrow : _type(), _numtype(number_float), _name_encoded(), _name(JSONWorker::FixString(name_t.data(), name_t.length(), NAME_ENCODED)), _string(), _string_encoded(), _value()
     initializeMutex(0)
     initializeRefCount(1)
     initializeFetch(false)
+    initializeIndex(0, 0)
+    initializeUnparsed()
     initializeComment(json_global(EMPTY_JSON_STRING))
     initializeChildren(0){
 
@@ -94,8 +101,6 @@ internalJSONNode::internalJSONNode(const json_string & name_t, const json_string
 	   }
     #endif
 
-    _string = value_t;
-
     const json_char firstchar = value_t[0];
     #if defined JSON_DEBUG || defined JSON_SAFE
 	   const json_char lastchar = value_t[value_t.length() - 1];
@@ -105,39 +110,58 @@ internalJSONNode::internalJSONNode(const json_string & name_t, const json_string
         case JSON_TEXT('\"'):  //a json_string literal, still escaped and with leading and trailing quotes
             JSON_ASSERT_SAFE(lastchar == JSON_TEXT('\"'), JSON_TEXT("Unterminated quote"), Nullify(); return;);
             _type = JSON_STRING;
+			_unparsed = value_t;
 			SetFetchedFalseOrDo(FetchString());
             break;
         case JSON_TEXT('{'):  //a child node, or set of children
             JSON_ASSERT_SAFE(lastchar == JSON_TEXT('}'), JSON_TEXT("Missing }"), Nullify(); return;);
             _type = JSON_NODE;
 			CHILDREN = jsonChildren::newChildren();
+			_unparsed = value_t;
+			#ifdef JSON_STRUCTURAL_INDEX
+				if (index != 0){
+					_index = index -> incRef();
+					_index_entry = entry;
+				}
+			#endif
 			SetFetchedFalseOrDo(FetchNode());
             break;
         case JSON_TEXT('['):  //an array
             JSON_ASSERT_SAFE(lastchar == JSON_TEXT(']'), JSON_TEXT("Missing ]"), Nullify(); return;);
             _type = JSON_ARRAY;
 			CHILDREN = jsonChildren::newChildren();
+			_unparsed = value_t;
+			#ifdef JSON_STRUCTURAL_INDEX
+				if (index != 0){
+					_index = index -> incRef();
+					_index_entry = entry;
+				}
+			#endif
 			SetFetchedFalseOrDo(FetchArray());
             break;
         LETTERCASE('t', 'T'):
-            JSON_ASSERT_SAFE(value_t == json_global(CONST_TRUE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t).c_str(), Nullify(); return;);
+            JSON_ASSERT_SAFE(value_t == json_global(CONST_TRUE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t.toString()).c_str(), Nullify(); return;);
+            _string.assign(value_t.data(), value_t.length());
             _value._bool = true;
             _type = JSON_BOOL;
 			SetFetched(true);
             break;
         LETTERCASE('f', 'F'):
-            JSON_ASSERT_SAFE(value_t == json_global(CONST_FALSE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t).c_str(), Nullify(); return;);
+            JSON_ASSERT_SAFE(value_t == json_global(CONST_FALSE), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t.toString()).c_str(), Nullify(); return;);
+            _string.assign(value_t.data(), value_t.length());
             _value._bool = false;
             _type = JSON_BOOL;
 			SetFetched(true);
             break;
         LETTERCASE('n', 'N'):
-            JSON_ASSERT_SAFE(value_t == json_global(CONST_NULL), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t).c_str(), Nullify(); return;);
+            JSON_ASSERT_SAFE(value_t == json_global(CONST_NULL), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t.toString()).c_str(), Nullify(); return;);
+            _string.assign(value_t.data(), value_t.length());
             _type = JSON_NULL;
 			SetFetched(true);
             break;
         default:
-            JSON_ASSERT_SAFE(NumberToString::isNumeric(value_t), json_string(json_global(ERROR_UNKNOWN_LITERAL) + value_t).c_str(), Nullify(); return;);
+            _string.assign(value_t.data(), value_t.length());  //numbers are short, so they keep their own copy for atof
+            JSON_ASSERT_SAFE(NumberToString::isNumeric(_string), json_string(json_global(ERROR_UNKNOWN_LITERAL) + _string).c_str(), Nullify(); return;);
 			_type = JSON_NUMBER;
 			SetFetchedFalseOrDo(FetchNumber());
             break;
@@ -152,77 +176,98 @@ internalJSONNode::~internalJSONNode(void) json_nothrow {
     #ifdef JSON_MUTEX_CALLBACKS
 	   _unset_mutex();
     #endif /*<- */
+    #ifdef JSON_STRUCTURAL_INDEX
+	   JSONStructuralIndex::decRef(_index);
+    #endif
     DELETE_CHILDREN();
 }
 
 #ifdef JSON_READ_PRIORITY
     void internalJSONNode::FetchString(void) const json_nothrow {
-	   JSON_ASSERT_SAFE(!_string.empty(), JSON_TEXT("JSON json_string type is empty?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[0] == JSON_TEXT('\"'), JSON_TEXT("JSON json_string type doesn't start with a quotation?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[_string.length() - 1] == JSON_TEXT('\"'), JSON_TEXT("JSON json_string type doesn't end with a quotation?"), Nullify(); return;);
-	   _string = JSONWorker::FixString(json_string(_string.begin() + 1, _string.end() - 1), STRING_ENCODED);
+	   JSON_ASSERT_SAFE(!_unparsed.empty(), JSON_TEXT("JSON json_string type is empty?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[0] == JSON_TEXT('\"'), JSON_TEXT("JSON json_string type doesn't start with a quotation?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[_unparsed.length() - 1] == JSON_TEXT('\"'), JSON_TEXT("JSON json_string type doesn't end with a quotation?"), Nullify(); return;);
+	   _string = JSONWorker::FixString(_unparsed.data() + 1, _unparsed.length() - 2, STRING_ENCODED);
+	   _unparsed.clear();
 	   #ifdef JSON_LESS_MEMORY
 		  JSON_ASSERT(_string.capacity() == _string.length(), JSON_TEXT("_string object too large 2"));
 	   #endif
     }
 
     void internalJSONNode::FetchNode(void) const json_nothrow {
-	   JSON_ASSERT_SAFE(!_string.empty(), JSON_TEXT("JSON node type is empty?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[0] == JSON_TEXT('{'), JSON_TEXT("JSON node type doesn't start with a bracket?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[_string.length() - 1] == JSON_TEXT('}'), JSON_TEXT("JSON node type doesn't end with a bracket?"), Nullify(); return;);
-	   JSONWorker::DoNode(this, _string);
-	   clearString(_string);
+	   JSON_ASSERT_SAFE(!_unparsed.empty(), JSON_TEXT("JSON node type is empty?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[0] == JSON_TEXT('{'), JSON_TEXT("JSON node type doesn't start with a bracket?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[_unparsed.length() - 1] == JSON_TEXT('}'), JSON_TEXT("JSON node type doesn't end with a bracket?"), Nullify(); return;);
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  if (_index == 0){  //nothing above this was indexed, so index it once for all of its descendants
+			 _index = JSONStructuralIndex::newIndex(_unparsed.data(), _unparsed.length());
+			 _index_entry = 0;
+		  }
+	   #endif
+	   JSONWorker::DoNode(this, _unparsed);
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  JSONStructuralIndex::decRef(_index);
+	   #endif
+	   _unparsed.clear();
     }
 
     void internalJSONNode::FetchArray(void) const json_nothrow {
-	   JSON_ASSERT_SAFE(!_string.empty(), JSON_TEXT("JSON node type is empty?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[0] == JSON_TEXT('['), JSON_TEXT("JSON node type doesn't start with a square bracket?"), Nullify(); return;);
-	   JSON_ASSERT_SAFE(_string[_string.length() - 1] == JSON_TEXT(']'), JSON_TEXT("JSON node type doesn't end with a square bracket?"), Nullify(); return;);
-	   JSONWorker::DoArray(this, _string);
-	   clearString(_string);
+	   JSON_ASSERT_SAFE(!_unparsed.empty(), JSON_TEXT("JSON node type is empty?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[0] == JSON_TEXT('['), JSON_TEXT("JSON node type doesn't start with a square bracket?"), Nullify(); return;);
+	   JSON_ASSERT_SAFE(_unparsed[_unparsed.length() - 1] == JSON_TEXT(']'), JSON_TEXT("JSON node type doesn't end with a square bracket?"), Nullify(); return;);
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  if (_index == 0){  //nothing above this was indexed, so index it once for all of its descendants
+			 _index = JSONStructuralIndex::newIndex(_unparsed.data(), _unparsed.length());
+			 _index_entry = 0;
+		  }
+	   #endif
+	   JSONWorker::DoArray(this, _unparsed);
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  JSONStructuralIndex::decRef(_index);
+	   #endif
+	   _unparsed.clear();
     }
 
 #endif
 
 //This one is used by as_int and as_float, so even non-readers need it
 void internalJSONNode::FetchNumber(void) const json_nothrow {
-    #ifdef JSON_STRICT
-		_value._number = NumberToString::_atof(_string.c_str());
-    #else
-	   #ifdef JSON_UNICODE
-		  const size_t len = _string.length();
-		  #if defined(_MSC_VER) && defined(JSON_SAFE)
-			 const size_t bytes = (len * (sizeof(json_char) / sizeof(char))) + 1;
-			 json_auto<char> temp(bytes);
-			 size_t res;
-			 errno_t err = wcstombs_s(&res, temp.ptr, bytes, _string.c_str(), len);
-			 if (err != 0){
-				_value._number = (json_number)0.0;
-				return;
-			 }
-		  #elif defined(JSON_SAFE)
-			 const size_t bytes = (len * (sizeof(json_char) / sizeof(char))) + 1;
-			 json_auto<char> temp(bytes);
-			 size_t res = std::wcstombs(temp.ptr, _string.c_str(), len);
-			 if (res == (size_t)-1){
-				_value._number = (json_number)0.0;
-				return;
-			 }
-		  #else
-			 json_auto<char> temp(len + 1);
-			 size_t res = std::wcstombs(temp.ptr, _string.c_str(), len);
-		  #endif
-		  temp.ptr[res] = '\0';
-		  _value._number = (json_number)std::atof(temp.ptr);
+    unsigned long long magnitude;
+    bool negative;
+    if (NumberToString::_atoi(_string.data(), _string.length(), magnitude, negative)){
+	   if (negative){
+		  setInteger((long long)(0ULL - magnitude));
+	   } else {
+		  setUnsigned(magnitude);
+	   }
+    } else {
+	   _numtype = number_float;
+	   #ifdef JSON_STRICT
+		  _value._number = NumberToString::_atof(_string.c_str());
 	   #else
-		  _value._number = (json_number)std::atof(_string.c_str());
+		  _value._number = JSONFloat::parse(_string.data(), _string.length());
 	   #endif
-    #endif
+    }
     #if((!defined(JSON_CASTABLE) && defined(JSON_LESS_MEMORY)) && !defined(JSON_WRITE_PRIORITY))
 	   clearString(_string);
     #endif
 }
 
+void internalJSONNode::appendNumber(json_string & output) const json_nothrow {
+    switch(_numtype){
+	   case number_integer:
+		  NumberToString::_itoa<long long>(_value._integer, output);
+		  return;
+	   case number_unsigned:
+		  NumberToString::_uitoa<unsigned long long>(_value._unsigned, output);
+		  return;
+	   case number_single:
+		  NumberToString::_ftoa<float>((float)_value._number, output);
+		  return;
+    }
+    NumberToString::_ftoa<json_number>(_value._number, output);
+}
+
 #if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
     void internalJSONNode::Fetch(void) const json_nothrow {
 	   if (fetched) return;
@@ -258,52 +303,35 @@ void internalJSONNode::Set(const json_string & val) json_nothrow {
     SetFetched(true);
 }
 
-#if(defined(JSON_CASTABLE) || !defined(JSON_LESS_MEMORY) || defined(JSON_WRITE_PRIORITY))
-   #define SET(converter, type)\
-	  void internalJSONNode::Set(type val) json_nothrow {\
-		 makeNotContainer();\
-		 _type = JSON_NUMBER;\
-		 _value._number = (json_number)val;\
-		 _string = NumberToString::converter<type>(val);\
-		 SetFetched(true);\
-	  }
-   #define SET_FLOAT(type) \
-	  void internalJSONNode::Set(type val) json_nothrow {\
-		 makeNotContainer();\
-		 _type = JSON_NUMBER;\
-		 _value._number = (json_number)val;\
-		 _string = NumberToString::_ftoa(_value._number);\
-		 SetFetched(true);\
-	  }
-#else /*<- else */
-   #define SET(converter, type)\
-	  void internalJSONNode::Set(type val) json_nothrow {\
-		 makeNotContainer();\
-		 _type = JSON_NUMBER;\
-		 _value._number = (json_number)val;\
-		 clearString(_string);\
-		 SetFetched(true);\
-	  }
-   #define SET_FLOAT(type) \
-	  void internalJSONNode::Set(type val) json_nothrow {\
-		 makeNotContainer();\
-		 _type = JSON_NUMBER;\
-		 _value._number = (json_number)val;\
-		 clearString(_string);\
-		 SetFetched(true);\
-	  }
-#endif
-#define SET_INTEGER(type) SET(_itoa, type) SET(_uitoa, unsigned type)
+//numbers are only kept as binary, they aren't turned into text until they're written or asked for
+#define SET(setter, type)\
+   void internalJSONNode::Set(type val) json_nothrow {\
+	  makeNotContainer();\
+	  _type = JSON_NUMBER;\
+	  setter(val);\
+	  clearString(_string);\
+	  SetFetched(true);\
+   }
+#define SET_FLOAT(type, kind)\
+   void internalJSONNode::Set(type val) json_nothrow {\
+	  makeNotContainer();\
+	  _type = JSON_NUMBER;\
+	  _value._number = (json_number)val;\
+	  _numtype = kind;\
+	  clearString(_string);\
+	  SetFetched(true);\
+   }
+#define SET_INTEGER(type) SET(setInteger, type) SET(setUnsigned, unsigned type)
 
 SET_INTEGER(char)
 SET_INTEGER(short)
 SET_INTEGER(int)
 SET_INTEGER(long)
 SET_INTEGER(long long)
-SET_FLOAT(long double)
+SET_FLOAT(long double, number_float)
 
-SET_FLOAT(float)
-SET_FLOAT(double)
+SET_FLOAT(float, number_single)
+SET_FLOAT(double, number_float)
 
 void internalJSONNode::Set(bool val) json_nothrow {
     makeNotContainer();
@@ -328,7 +356,10 @@ bool internalJSONNode::IsEqualTo(const internalJSONNode * val) const json_nothro
 	   case JSON_STRING:
 		  return val -> _string == _string;
 	   case JSON_NUMBER:
-		  return _floatsAreEqual(val -> _value._number, _value._number);
+		  if (_numtype >= number_integer && _numtype == val -> _numtype){  //both whole, so they can be compared exactly
+			 return (_numtype == number_integer) ? (val -> _value._integer == _value._integer) : (val -> _value._unsigned == _value._unsigned);
+		  }
+		  return _floatsAreEqual(val -> number(), number());
 	   case JSON_BOOL:
 		  return val -> _value._bool == _value._bool;
     };
@@ -350,6 +381,12 @@ bool internalJSONNode::IsEqualTo(const internalJSONNode * val) const json_nothro
 
 void internalJSONNode::Nullify(void) const json_nothrow {
     _type = JSON_NULL;
+    #ifdef JSON_STRUCTURAL_INDEX
+	   JSONStructuralIndex::decRef(_index);
+    #endif
+    #ifdef JSON_READ_PRIORITY
+	   _unparsed.clear();
+    #endif
     #if(defined(JSON_CASTABLE) || !defined(JSON_LESS_MEMORY) || defined(JSON_WRITE_PRIORITY)) /*-> JSON_CASTABLE || !JSON_LESS_MEMORY || JSON_WRITE_PRIORITY */
 	   _string = json_global(CONST_NULL);
     #else /*<- else */
@@ -455,6 +492,59 @@ JSONNode ** internalJSONNode::at(const json_string & name_t) json_nothrow {
 		  }
 	   }
     }
+
+    #ifdef JSON_THREADS
+	   struct json_preparse_job {
+		  JSONNode ** children;
+		  size_t count;
+		  volatile size_t next;
+	   };
+
+	   static void preparseChildren(void * arg) json_nothrow {
+		  json_preparse_job * job = (json_preparse_job *)arg;
+		  for(size_t i = JSONThreads::fetchAdd(job -> next); i < job -> count; i = JSONThreads::fetchAdd(job -> next)){
+			 job -> children[i] -> preparse();
+		  }
+	   }
+    #endif
+
+    /*
+	   Fetches this level on the calling thread, then hands the children out to
+	   a pool of threads that each parse whole subtrees.  The children are
+	   already in order in CHILDREN, so nothing has to be put back together
+    */
+    void internalJSONNode::preparse_parallel(unsigned int threads) json_nothrow {
+	   Fetch();
+	   if (!isContainer()) return;
+	   #ifdef JSON_THREADS
+		  if (threads == 0) threads = JSONThreads::hardware();
+		  if (threads > CHILDREN -> size()) threads = (unsigned int)CHILDREN -> size();
+		  if (threads > 1){
+			 //the children all point into this node's text and index, whose reference counts have no locks on them
+			 json_foreach(CHILDREN, myrunner){
+				(*myrunner) -> internal -> unshare();
+			 }
+			 json_preparse_job job;
+			 job.children = CHILDREN -> begin();
+			 job.count = CHILDREN -> size();
+			 job.next = 0;
+			 JSONThreads::run(threads, preparseChildren, &job);
+			 return;
+		  }
+	   #endif
+	   preparse();
+    }
+
+    //gives an unfetched node its own copy of its text, so that it can be fetched without touching anything it shares
+    void internalJSONNode::unshare(void) const json_nothrow {
+	   if (fetched) return;
+	   if (!_unparsed.empty()){
+		  _unparsed = json_shared_string(_unparsed.data(), _unparsed.length());
+	   }
+	   #ifdef JSON_STRUCTURAL_INDEX
+		  JSONStructuralIndex::decRef(_index);  //it will index its own text when it's fetched
+	   #endif
+    }
 #endif /*<- */
 
 internalJSONNode::operator bool() const json_nothrow {
@@ -462,7 +552,7 @@ internalJSONNode::operator bool() const json_nothrow {
     #ifdef JSON_CASTABLE /*-> JSON_CASTABLE */
 	   switch(type()){
 		  case JSON_NUMBER:
-			 return !_floatsAreEqual(_value._number, (json_number)0.0);
+			 return !_floatsAreEqual(number(), (json_number)0.0);
 		  case JSON_NULL:
 			 return false;
 	   }
@@ -484,6 +574,12 @@ internalJSONNode::operator long double() const json_nothrow {
 	  }
    #endif /*<- */
    JSON_ASSERT(type() == JSON_NUMBER, json_global(ERROR_UNDEFINED) + JSON_TEXT("(long double)"));
+   switch(_numtype){
+	  case number_integer:
+		 return (long double)_value._integer;
+	  case number_unsigned:
+		 return (long double)_value._unsigned;
+   }
    return (long double)_value._number;
 }
 
@@ -502,6 +598,9 @@ internalJSONNode::operator long long() const json_nothrow
 	  }
    #endif /*<- */
    JSON_ASSERT(type() == JSON_NUMBER, json_global(ERROR_UNDEFINED) + JSON_TEXT("(long long)"));
+   if (json_likely(_numtype == number_integer)) return _value._integer;  //no conversion at all
+   JSON_ASSERT(_numtype != number_unsigned, _string + json_global(ERROR_UPPER_RANGE) + JSON_TEXT("long long"));
+   if (_numtype == number_unsigned) return (long long)_value._unsigned;
    #ifdef LONG_LONG_MAX
 	  JSON_ASSERT(_value._number < LONG_LONG_MAX, _string + json_global(ERROR_UPPER_RANGE) + JSON_TEXT("long long"));
    #elif defined(LLONG_MAX)
@@ -531,6 +630,11 @@ internalJSONNode::operator unsigned long long() const json_nothrow
 	  }
    #endif /*<- */
    JSON_ASSERT(type() == JSON_NUMBER, json_global(ERROR_UNDEFINED) + JSON_TEXT("(unsigned long long)"));
+   if (json_likely(_numtype == number_integer)){
+	  JSON_ASSERT(_value._integer >= 0, _string + json_global(ERROR_LOWER_RANGE) + JSON_TEXT("unsigned long long"));
+	  return (unsigned long long)_value._integer;
+   }
+   if (_numtype == number_unsigned) return _value._unsigned;
    JSON_ASSERT(_value._number > 0, _string + json_global(ERROR_LOWER_RANGE) + JSON_TEXT("unsigned long long"));
    #ifdef ULONG_LONG_MAX
 	  JSON_ASSERT(_value._number < ULONG_LONG_MAX, _string + json_global(ERROR_UPPER_RANGE) + JSON_TEXT("unsigned long long"));
@@ -580,7 +684,7 @@ internalJSONNode * internalJSONNode::newInternal(char mytype) {
 }
 
 #ifdef JSON_READ_PRIORITY /*-> JSON_READ_PRIORITY */
-internalJSONNode * internalJSONNode::newInternal(const json_string & unparsed) {
+internalJSONNode * internalJSONNode::newInternal(const json_shared_string & unparsed) {
 	#ifdef JSON_MEMORY_POOL /*-> JSON_MEMORY_POOL */
 		return new((internalJSONNode*)json_internal_mempool.allocate()) internalJSONNode(unparsed);
 	#elif defined(JSON_MEMORY_CALLBACKS) /*<- else JSON_MEMORY_CALLBACKS */
@@ -590,13 +694,13 @@ internalJSONNode * internalJSONNode::newInternal(const json_string & unparsed) {
 	#endif /*<- */
 }
 
-internalJSONNode * internalJSONNode::newInternal(const json_string & name_t, const json_string & value_t) {
+internalJSONNode * internalJSONNode::newInternal(const json_shared_string & name_t, const json_shared_string & value_t STRUCTURAL_PARAM) {
 	#ifdef JSON_MEMORY_POOL /*-> JSON_MEMORY_POOL */
-		return new((internalJSONNode*)json_internal_mempool.allocate()) internalJSONNode(name_t, value_t);
+		return new((internalJSONNode*)json_internal_mempool.allocate()) internalJSONNode(name_t, value_t STRUCTURAL_ARG(index, entry));
 	#elif defined(JSON_MEMORY_CALLBACKS) /*<- else JSON_MEMORY_CALLBACKS */
-		return new(json_malloc<internalJSONNode>(1)) internalJSONNode(name_t, value_t);
+		return new(json_malloc<internalJSONNode>(1)) internalJSONNode(name_t, value_t STRUCTURAL_ARG(index, entry));
 	#else /*<- else */
-		return new internalJSONNode(name_t, value_t);
+		return new internalJSONNode(name_t, value_t STRUCTURAL_ARG(index, entry));
 	#endif /*<- */
 }
 
@@ -680,7 +784,17 @@ internalJSONNode * internalJSONNode::newInternal(const internalJSONNode & orig)
 		  if (type() == JSON_BOOL){
 			 unio.push_back(JSON_NEW(JSONNode(JSON_TEXT("_bool"), _value._bool)));
 		  } else if (type() == JSON_NUMBER){
-			 unio.push_back(JSON_NEW(JSONNode(JSON_TEXT("_number"), _value._number)));
+			 switch(_numtype){
+				case number_integer:
+				    unio.push_back(JSON_NEW(JSONNode(JSON_TEXT("_integer"), _value._integer)));
+				    break;
+				case number_unsigned:
+				    unio.push_back(JSON_NEW(JSONNode(JSON_TEXT("_unsigned"), _value._unsigned)));
+				    break;
+				default:
+				    unio.push_back(JSON_NEW(JSONNode(JSON_TEXT("_number"), _value._number)));
+				    break;
+			 }
 		  }
 		  dumpage.push_back(JSON_NEW(unio));
 	   }
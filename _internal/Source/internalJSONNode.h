@@ -8,7 +8,9 @@
 #ifdef JSON_DEBUG
     #include <climits>  //to check int value
 #endif
+#include <limits>  //for the largest long long
 #include "JSONSharedString.h"
+#include "JSONStructuralIndex.h"
 
 #ifdef JSON_LESS_MEMORY
     #ifdef __GNUC__
@@ -46,6 +48,18 @@ class JSONNode;  //forward declaration
     #define initializeFetch(x) ,fetched(x)
 #endif
 
+#ifdef JSON_STRUCTURAL_INDEX
+    #define initializeIndex(x, y) ,_index(x), _index_entry(y)
+#else
+    #define initializeIndex(x, y)
+#endif
+
+#ifdef JSON_READ_PRIORITY
+    #define initializeUnparsed(x) ,_unparsed(x)
+#else
+    #define initializeUnparsed(x)
+#endif
+
 #ifdef JSON_REF_COUNT
     #define initializeRefCount(x) ,refcount(x)
 #else
@@ -81,8 +95,8 @@ public:
 	LIBJSON_OBJECT(internalJSONNode);
     internalJSONNode(char mytype = JSON_NULL) json_nothrow json_hot;
     #ifdef JSON_READ_PRIORITY
-	   internalJSONNode(const json_string & unparsed) json_nothrow json_hot;
-	   internalJSONNode(const json_string & name_t, const json_string & value_t) json_nothrow json_read_priority;
+	   internalJSONNode(const json_shared_string & unparsed) json_nothrow json_hot;
+	   internalJSONNode(const json_shared_string & name_t, const json_shared_string & value_t STRUCTURAL_PARAM) json_nothrow json_read_priority;
     #endif
     internalJSONNode(const internalJSONNode & orig) json_nothrow json_hot;
     internalJSONNode & operator = (const internalJSONNode &) json_nothrow json_hot;
@@ -90,8 +104,8 @@ public:
 
     static internalJSONNode * newInternal(char mytype = JSON_NULL) json_hot;
     #ifdef JSON_READ_PRIORITY
-	   static internalJSONNode * newInternal(const json_string & unparsed) json_hot;
-	   static internalJSONNode * newInternal(const json_string & name_t, const json_string & value_t) json_hot;
+	   static internalJSONNode * newInternal(const json_shared_string & unparsed) json_hot;
+	   static internalJSONNode * newInternal(const json_shared_string & name_t, const json_shared_string & value_t STRUCTURAL_PARAM) json_hot;
     #endif
     static internalJSONNode * newInternal(const internalJSONNode & orig) json_hot;  //not copyable, only by this class
     static void deleteInternal(internalJSONNode * ptr) json_nothrow json_hot;
@@ -109,6 +123,7 @@ public:
 
     #if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
 	   void preparse(void) json_nothrow;
+	   void preparse_parallel(unsigned int threads) json_nothrow;
     #endif
 
     void push_back(const JSONNode & node) json_nothrow;
@@ -211,6 +226,10 @@ public:
 	   void Fetch(void) const json_nothrow json_hot;  //it's const because it doesn't change the VALUE of the function
     #endif
 
+    #if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+	   void unshare(void) const json_nothrow;
+    #endif
+
     #ifdef JSON_READ_PRIORITY
 	   void FetchString(void) const json_nothrow json_read_priority;
 	   void FetchNode(void) const json_nothrow json_read_priority;
@@ -218,6 +237,18 @@ public:
     #endif
     void FetchNumber(void) const json_nothrow json_read_priority;
 
+    //which member of _value a JSON_NUMBER is being kept in
+    enum number_type {
+	   number_float,
+	   number_single,  //set from a float, so it's written with only the digits that a float has
+	   number_integer,
+	   number_unsigned  //only whole numbers too big for a long long
+    };
+    json_number number(void) const json_nothrow json_hot;
+    void appendNumber(json_string & output) const json_nothrow;
+    void setInteger(long long val) const json_nothrow;
+    void setUnsigned(unsigned long long val) const json_nothrow;
+
     #ifdef JSON_CASE_INSENSITIVE_FUNCTIONS
 	   static bool AreEqualNoCase(const json_char * ch_one, const json_char * ch_two) json_nothrow json_read_priority;
     #endif
@@ -233,6 +264,7 @@ public:
 
 
     mutable unsigned char _type BITS(3);
+    mutable unsigned char _numtype BITS(2);
 
     json_string _name;
     mutable bool _name_encoded BITS(1);  //must be above name due to initialization list order
@@ -244,6 +276,8 @@ public:
     union value_union_t {
 	   bool _bool BITS(1);
 	   json_number _number;
+	   long long _integer;  //whole numbers are kept exactly, not rounded to a json_number
+	   unsigned long long _unsigned;
 	   #ifdef JSON_LESS_MEMORY
 		  jsonChildren * Children;
 	   #endif
@@ -262,6 +296,15 @@ public:
 	   mutable bool fetched BITS(1);
     #endif
 
+    #ifdef JSON_STRUCTURAL_INDEX
+	   mutable JSONStructuralIndex * _index;  //only held while an unparsed container is waiting to be fetched
+	   mutable json_index_t _index_entry;
+    #endif
+
+    #ifdef JSON_READ_PRIORITY
+	   mutable json_shared_string _unparsed;  //the raw text of an unfetched string, node or array, it points into the document it was parsed from
+    #endif
+
     #ifdef JSON_COMMENTS
 	   json_string _comment;
     #endif
@@ -271,10 +314,12 @@ public:
     #endif
 };
 
-inline internalJSONNode::internalJSONNode(char mytype) json_nothrow : _type(mytype), _name(), _name_encoded(), _string(), _string_encoded(), _value()
+inline internalJSONNode::internalJSONNode(char mytype) json_nothrow : _type(mytype), _numtype(number_float), _name(), _name_encoded(), _string(), _string_encoded(), _value()
     initializeMutex(0)
     initializeRefCount(1)
     initializeFetch(true)
+    initializeIndex(0, 0)
+    initializeUnparsed()
     initializeComment(json_global(EMPTY_JSON_STRING))
     initializeChildren((_type == JSON_NODE || _type == JSON_ARRAY) ? jsonChildren::newChildren() : 0){
 
@@ -351,7 +396,27 @@ template<typename T>
 inline bool internalJSONNode::IsEqualToNum(T val) const json_nothrow {
     if (type() != JSON_NUMBER) return false;
     Fetch();
-    return (json_number)val == _value._number;
+    return (json_number)val == number();
+}
+
+inline json_number internalJSONNode::number(void) const json_nothrow {
+    if (json_likely(_numtype < number_integer)) return _value._number;
+    if (_numtype == number_integer) return (json_number)_value._integer;
+    return (json_number)_value._unsigned;
+}
+
+inline void internalJSONNode::setInteger(long long val) const json_nothrow {
+    _value._integer = val;
+    _numtype = number_integer;
+}
+
+inline void internalJSONNode::setUnsigned(unsigned long long val) const json_nothrow {
+    if (json_likely(val <= (unsigned long long)std::numeric_limits<long long>::max())){
+	   setInteger((long long)val);
+    } else {
+	   _value._unsigned = val;
+	   _numtype = number_unsigned;
+    }
 }
 
 #ifdef JSON_REF_COUNT
@@ -381,6 +446,7 @@ inline internalJSONNode * internalJSONNode::makeUnique(void) json_nothrow {
 #if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
     inline void internalJSONNode::SetFetched(bool val) const json_nothrow {
 	   fetched = val;
+	   if (val) _unparsed.clear();  //nothing will need the raw text anymore
     }
 #endif
 
@@ -427,27 +493,33 @@ inline JSONNode * internalJSONNode::at(json_index_t pos) json_nothrow {
     cast operators
 */
 #define BASE_CONVERT_TYPE long long
+#define BASE_CONVERT_UTYPE unsigned long long  //so that unsigned values too big for a long long still come out right
 
-#define IMP_SMALLER_INT_CAST_OP(_type, type_max, type_min)\
+#define IMP_SMALLER_INT_CAST_OP(_type, type_max, type_min, base)\
    inline internalJSONNode::operator _type() const json_nothrow {\
-	  JSON_ASSERT(_value._number > type_min, _string + json_global(ERROR_LOWER_RANGE) + JSON_TEXT(#_type));\
-	  JSON_ASSERT(_value._number < type_max, _string + json_global(ERROR_UPPER_RANGE) + JSON_TEXT(#_type));\
-	  JSON_ASSERT(_value._number == (json_number)((_type)(_value._number)), json_string(JSON_TEXT("(")) + json_string(JSON_TEXT(#_type)) + json_string(JSON_TEXT(") will truncate ")) + _string);\
-	  return (_type)static_cast<BASE_CONVERT_TYPE>(*this);\
+	  JSON_ASSERT(number() > type_min, _string + json_global(ERROR_LOWER_RANGE) + JSON_TEXT(#_type));\
+	  JSON_ASSERT(number() < type_max, _string + json_global(ERROR_UPPER_RANGE) + JSON_TEXT(#_type));\
+	  JSON_ASSERT(number() == (json_number)((_type)(number())), json_string(JSON_TEXT("(")) + json_string(JSON_TEXT(#_type)) + json_string(JSON_TEXT(") will truncate ")) + _string);\
+	  return (_type)static_cast<base>(*this);\
    }
 
-IMP_SMALLER_INT_CAST_OP(char, CHAR_MAX, CHAR_MIN)
-IMP_SMALLER_INT_CAST_OP(unsigned char, UCHAR_MAX, 0)
-IMP_SMALLER_INT_CAST_OP(short, SHRT_MAX, SHRT_MIN)
-IMP_SMALLER_INT_CAST_OP(unsigned short, USHRT_MAX, 0)
-IMP_SMALLER_INT_CAST_OP(int, INT_MAX, INT_MIN)
-IMP_SMALLER_INT_CAST_OP(unsigned int, UINT_MAX, 0)
+IMP_SMALLER_INT_CAST_OP(char, CHAR_MAX, CHAR_MIN, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(unsigned char, UCHAR_MAX, 0, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(short, SHRT_MAX, SHRT_MIN, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(unsigned short, USHRT_MAX, 0, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(int, INT_MAX, INT_MIN, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(unsigned int, UINT_MAX, 0, BASE_CONVERT_TYPE)
 
-IMP_SMALLER_INT_CAST_OP(long, LONG_MAX, LONG_MIN)
-IMP_SMALLER_INT_CAST_OP(unsigned long, ULONG_MAX, 0)
+IMP_SMALLER_INT_CAST_OP(long, LONG_MAX, LONG_MIN, BASE_CONVERT_TYPE)
+IMP_SMALLER_INT_CAST_OP(unsigned long, ULONG_MAX, 0, BASE_CONVERT_UTYPE)
 
 inline internalJSONNode::operator json_string() const json_nothrow {
     Fetch();
+    if (type() == JSON_NUMBER && _string.empty()){  //numbers that were set don't have text until something asks for it
+	   json_string res;
+	   appendNumber(res);
+	   return res;
+    }
     return _string;
 }
 
@@ -7,6 +7,10 @@
 #include "../TestSuite2/JSONDebug/JSON_FAIL.h"
 #include "../TestSuite2/JSONDebug/JSON_FAIL_SAFE.h"
 #include "../TestSuite2/JSONGlobals/jsonSingleton.h"
+#include "../TestSuite2/JSONSimd/RemoveWhiteSpace.h"
+#include "../TestSuite2/JSONStructuralIndex/newIndex.h"
+#include "../TestSuite2/JSONUtf8/isValid.h"
+#include "../TestSuite2/JSONUtf8/isValid_benchmark.h"
 #include "../TestSuite2/JSONValidator/isValidArray.h"
 #include "../TestSuite2/JSONValidator/isValidMember.h"
 #include "../TestSuite2/JSONValidator/isValidNamedObject.h"
@@ -17,10 +21,26 @@
 #include "../TestSuite2/JSONValidator/isValidString.h"
 #include "../TestSuite2/JSONValidator/Resources/validyMacros.h"
 #include "../TestSuite2/JSONValidator/securityTest.h"
+#include "../TestSuite2/JSONDocument/parse.h"
+#include "../TestSuite2/JSONSax/parse.h"
+#include "../TestSuite2/JSONReader/next.h"
+#include "../TestSuite2/JSONFloat/parse.h"
+#include "../TestSuite2/JSONNode/preparse_parallel.h"
+#include "../TestSuite2/JSONNode/as_int.h"
+#include "../TestSuite2/JSONNode/as_string.h"
+#include "../TestSuite2/JSONWorker/extract.h"
+#include "../TestSuite2/JSONWorker/FixString.h"
+#include "../TestSuite2/JSONWorker/parse.h"
+#include "../TestSuite2/JSONWorker/parse_insitu.h"
+#include "../TestSuite2/JSONWorker/parse_scratch.h"
+#include "../TestSuite2/JSONWorker/UnfixString.h"
 #include "../TestSuite2/NumberToString/_areFloatsEqual.h"
 #include "../TestSuite2/NumberToString/_atof.h"
+#include "../TestSuite2/NumberToString/_atof_benchmark.h"
+#include "../TestSuite2/NumberToString/_atoi.h"
 #include "../TestSuite2/NumberToString/_ftoa.h"
 #include "../TestSuite2/NumberToString/_itoa.h"
+#include "../TestSuite2/NumberToString/_itoa_benchmark.h"
 #include "../TestSuite2/NumberToString/_uitoa.h"
 #include "../TestSuite2/NumberToString/getLenSize.h"
 #include "../TestSuite2/NumberToString/isNumeric.h"
@@ -60,6 +80,32 @@ void RunTestSuite2::RunTests(void){
         RUNTEST(testValue);
         RUNTEST(testNoValue);
     }
+    {
+        testJSONSimd__RemoveWhiteSpace ttt("testJSONSimd__RemoveWhiteSpace");
+        RUNTEST(testWhiteSpace);
+        RUNTEST(testStrings);
+        RUNTEST(testComments);
+        RUNTEST(testHighCharacters);
+    }
+    {
+        testJSONStructuralIndex__newIndex ttt("testJSONStructuralIndex__newIndex");
+        RUNTEST(testMatching);
+        RUNTEST(testStrings);
+        RUNTEST(testUnbalanced);
+        RUNTEST(testParse);
+    }
+    {
+        testJSONUtf8__isValid ttt("testJSONUtf8__isValid");
+        RUNTEST(testAscii);
+        RUNTEST(testMultiByte);
+        RUNTEST(testInvalid);
+        RUNTEST(testParse);
+        RUNTEST(testSameAsScan);
+    }
+    {
+        testJSONUtf8__isValid_benchmark ttt("testJSONUtf8__isValid_benchmark");
+        RUNTEST(testSpeed);
+    }
     {
         testJSONValidator__isValidMember ttt("testJSONValidator__isValidMember");
         RUNTEST(testMembers);
@@ -83,6 +129,7 @@ void RunTestSuite2::RunTests(void){
         RUNTEST(testRoots);
         RUNTEST(testNotRoots);
         RUNTEST(testSuddenEnd);
+        RUNTEST(testLength);
     }
     {
         testJSONValidator__isValidString ttt("testJSONValidator__isValidString");
@@ -97,6 +144,94 @@ void RunTestSuite2::RunTests(void){
         testJSONValidator__securityTest ttt("testJSONValidator__securityTest");
         RUNTEST(testsecurity);
     }
+    {
+        testJSONDocument__parse ttt("testJSONDocument__parse");
+        RUNTEST(testNavigation);
+        RUNTEST(testIterators);
+        RUNTEST(testStrings);
+        RUNTEST(testToNode);
+        RUNTEST(testInvalid);
+    }
+    {
+        testJSONSax__parse ttt("testJSONSax__parse");
+        RUNTEST(testEvents);
+        RUNTEST(testStrings);
+        RUNTEST(testStop);
+        RUNTEST(testInvalid);
+    }
+    {
+        testJSONReader__next ttt("testJSONReader__next");
+        RUNTEST(testTokens);
+        RUNTEST(testSkip);
+        RUNTEST(testStrings);
+        RUNTEST(testInvalid);
+    }
+    {
+        testJSONFloat__parse ttt("testJSONFloat__parse");
+        RUNTEST(testSimple);
+        RUNTEST(testExact);
+        RUNTEST(testLongDigits);
+        RUNTEST(testLimits);
+        RUNTEST(testRandom);
+        RUNTEST(testNotDecimal);
+    }
+    {
+        testJSONNode__preparse_parallel ttt("testJSONNode__preparse_parallel");
+        RUNTEST(testArray);
+        RUNTEST(testObject);
+        RUNTEST(testInsitu);
+        RUNTEST(testSmall);
+    }
+    {
+        testJSONNode__as_int ttt("testJSONNode__as_int");
+        RUNTEST(testParsed);
+        RUNTEST(testSet);
+        RUNTEST(testEquality);
+    }
+    {
+        testJSONNode__as_string ttt("testJSONNode__as_string");
+        RUNTEST(testDeferred);
+        RUNTEST(testFloatDigits);
+        RUNTEST(testParsed);
+    }
+    {
+        testJSONWorker__extract ttt("testJSONWorker__extract");
+        RUNTEST(testExtract);
+        RUNTEST(testEscapes);
+        RUNTEST(testMissing);
+        RUNTEST(testAtPointer);
+    }
+    {
+        testJSONWorker__FixString ttt("testJSONWorker__FixString");
+        RUNTEST(testPlain);
+        RUNTEST(testEscapes);
+        RUNTEST(testUnicode);
+        RUNTEST(testHex);
+    }
+    {
+        testJSONWorker__parse ttt("testJSONWorker__parse");
+        RUNTEST(testPointerAndLength);
+        RUNTEST(testUnformatted);
+        RUNTEST(testStringView);
+    }
+    {
+        testJSONWorker__parse_insitu ttt("testJSONWorker__parse_insitu");
+        RUNTEST(testSameAsParse);
+        RUNTEST(testStrings);
+        RUNTEST(testComments);
+        RUNTEST(testCopies);
+    }
+    {
+        testJSONWorker__parse_scratch ttt("testJSONWorker__parse_scratch");
+        RUNTEST(testSameAsParse);
+        RUNTEST(testReused);
+    }
+    {
+        testJSONWorker__UnfixString ttt("testJSONWorker__UnfixString");
+        RUNTEST(testPlain);
+        RUNTEST(testEscapes);
+        RUNTEST(testUnicode);
+    }
     {
         testNumberToString__areFloatsEqual ttt("testNumberToString__areFloatsEqual");
         RUNTEST(testEqual);
@@ -115,11 +250,23 @@ void RunTestSuite2::RunTests(void){
         RUNTEST(testStrict);
         RUNTEST(testNotNumbers);
     }
+    {
+        testNumberToString__atof_benchmark ttt("testNumberToString__atof_benchmark");
+        RUNTEST(testSpeed);
+    }
+    {
+        testNumberToString__atoi ttt("testNumberToString__atoi");
+        RUNTEST(testWhole);
+        RUNTEST(testLimits);
+        RUNTEST(testNotWhole);
+    }
 
     {
         testNumberToString__ftoa ttt("testNumberToString__ftoa");
         RUNTEST(testRandomNumbers);
         RUNTEST(testSpecializedInts);
+        RUNTEST(testExponents);
+        RUNTEST(testRoundTrip);
     }
     {
         testNumberToString__itoa ttt("testNumberToString__itoa");
@@ -128,6 +275,12 @@ void RunTestSuite2::RunTests(void){
         RUNTEST(testInt);
         RUNTEST(testLong);
         RUNTEST(testLongLong);
+        RUNTEST(testExtremes);
+        RUNTEST(testAppend);
+    }
+    {
+        testNumberToString__itoa_benchmark ttt("testNumberToString__itoa_benchmark");
+        RUNTEST(testSpeed);
     }
     {
         testNumberToString__uitoa ttt("testNumberToString__uitoa");
@@ -136,6 +289,7 @@ void RunTestSuite2::RunTests(void){
         RUNTEST(testInt);
         RUNTEST(testLong);
         RUNTEST(testLongLong);
+        RUNTEST(testAppend);
     }
     {
         testNumberToString__getLenSize ttt("testNumberToString__getLenSize");
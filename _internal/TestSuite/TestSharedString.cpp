@@ -121,5 +121,47 @@ void TestSuite::TestSharedString(void){
 	assertEquals(blah, blahs.toString());
 	assertEquals(sub, subs.toString());
 	assertEquals(sub.length(), subs.length());
+	
+	UnitTest::SetPrefix("TestSharedString.cpp - Empty");
+	json_shared_string nothing;
+	#ifdef JSON_UNIT_TEST
+		assertNull(nothing._str);
+	#endif
+	assertTrue(nothing.empty());
+	assertEquals(json_string::npos, nothing.find(JSON_TEXT('a')));
+	assertTrue(nothing == json_string());
+	json_shared_string nothing_copy(nothing);
+	assertEquals(0, nothing_copy.length());
+	
+	UnitTest::SetPrefix("TestSharedString.cpp - Comparing without copying");
+	json_shared_string world(blahs, 6, 5);
+	assertTrue(world == json_string(JSON_TEXT("world")));
+	assertFalse(world == json_string(JSON_TEXT("worlds")));
+	assertFalse(world == json_string(JSON_TEXT("hello")));
+	#ifdef JSON_UNIT_TEST
+		assertEquals(blahs._str, world._str);
+		assertEquals(6, world.offset);
+	#endif
+	
+	UnitTest::SetPrefix("TestSharedString.cpp - Finding in a slice");
+	json_shared_string worldonly(json_shared_string(blah), 6, 5);  //the only reference left, but still sliced
+	assertEquals(0, worldonly.find(JSON_TEXT('w')));
+	assertEquals(json_string::npos, worldonly.find(JSON_TEXT('h')));
+	
+	UnitTest::SetPrefix("TestSharedString.cpp - Clearing");
+	#ifdef JSON_UNIT_TEST
+		size_t before = blahs._str -> refCount;
+	#endif
+	world.clear();
+	assertTrue(world.empty());
+	#ifdef JSON_UNIT_TEST
+		assertNull(world._str);
+		assertEquals(before - 1, blahs._str -> refCount);
+	#endif
+	
+	UnitTest::SetPrefix("TestSharedString.cpp - From a buffer");
+	json_shared_string buffered(blah.data(), 5);
+	assertEquals(5, buffered.length());
+	assertEquals(json_string(JSON_TEXT("hello")), buffered.toString());
 }
 
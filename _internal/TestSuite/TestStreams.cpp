@@ -1,4 +1,5 @@
 #include "TestSuite.h"
+#include "../Source/JSONThreads.h"
 
 #ifdef JSON_STREAM
 unsigned int counter = 0;
@@ -43,6 +44,149 @@ void Callback(JSONNode & test, void * ide){
 		  break;
     }
 }
+
+unsigned int pieceCounter = 0;
+void PieceCallback(JSONNode & test, void *);
+void PieceCallback(JSONNode & test, void *){
+    ++pieceCounter;
+    switch(pieceCounter){
+	   case 1:
+		  assertEquals(test.type(), JSON_NODE);
+		  assertEquals(test.size(), 2);
+		  assertEquals(test[0].as_string(), JSON_TEXT("x\"}["));
+		  assertEquals(test[1].as_string(), JSON_TEXT("\\"));
+		  break;
+	   case 2:
+		  assertEquals(test.type(), JSON_ARRAY);
+		  assertEquals(test.size(), 2);
+		  assertEquals(test[1][0].name(), JSON_TEXT("b"));
+		  assertEquals(test[1][0].as_string(), JSON_TEXT("]"));
+		  break;
+    }
+}
+
+JSONNode kept;
+void KeepCallback(JSONNode & test, void *);
+void KeepCallback(JSONNode & test, void *){
+    if (kept.empty()) kept = test;
+    ++pieceCounter;
+}
+
+void LineCallback(JSONNode & test, void *);
+void LineCallback(JSONNode & test, void *){
+    ++pieceCounter;
+    switch(pieceCounter){
+	   case 1:
+		  assertEquals(test.type(), JSON_NODE);
+		  assertEquals(test[JSON_TEXT("a")].as_int(), 1);
+		  break;
+	   case 2:
+		  assertEquals(test.type(), JSON_ARRAY);
+		  assertEquals(test[0].as_int(), 2);
+		  break;
+	   case 3:
+		  assertEquals(test.type(), JSON_STRING);
+		  assertEquals(test.as_string(), JSON_TEXT("thr\"ee"));
+		  break;
+	   case 4:
+		  assertEquals(test.type(), JSON_NUMBER);
+		  assertEquals(test.as_float(), 4.5);
+		  break;
+	   case 5:
+		  assertEquals(test.type(), JSON_BOOL);
+		  assertTrue(test.as_bool());
+		  break;
+	   case 6:
+		  assertEquals(test.type(), JSON_NULL);
+		  break;
+	   case 7:
+		  assertEquals(test.type(), JSON_NUMBER);
+		  assertEquals(test.as_int(), -7);
+		  break;
+    }
+}
+
+unsigned int batchCounter = 0;
+void BatchCallback(JSONNode & test, void *);
+void BatchCallback(JSONNode & test, void *){
+    ++batchCounter;
+    assertEquals(test.type(), JSON_ARRAY);
+    pieceCounter += (unsigned int)test.size();
+}
+
+//the unordered ones are called on several threads at once, so they only write down what they saw
+const int parallelRecords = 1000;
+int parallelSeen[parallelRecords];
+void ElementCallback(JSONNode & test, void *);
+void ElementCallback(JSONNode & test, void *){
+    ++pieceCounter;
+    switch(pieceCounter){
+	   case 1:
+		  assertEquals(test.type(), JSON_NODE);
+		  assertEquals(test[JSON_TEXT("a")].as_string(), JSON_TEXT("x]"));
+		  break;
+	   case 2:
+		  assertEquals(test.type(), JSON_NUMBER);
+		  assertEquals(test.as_int(), 2);
+		  break;
+	   case 3:
+		  assertEquals(test.type(), JSON_STRING);
+		  assertEquals(test.as_string(), JSON_TEXT("thr\"ee"));
+		  break;
+	   case 4:
+		  assertEquals(test.type(), JSON_ARRAY);
+		  assertEquals(test.size(), 2);
+		  assertEquals(test[1][0].as_int(), 2);
+		  break;
+	   case 5:
+		  assertEquals(test.type(), JSON_NULL);
+		  break;
+    }
+}
+
+volatile size_t parallelCounter = 0;
+bool parallelInOrder = true;
+void ParallelCallback(JSONNode & test, void *);
+void ParallelCallback(JSONNode & test, void *){
+    #ifdef JSON_THREADS
+	   const size_t count = JSONThreads::fetchAdd(parallelCounter);
+    #else
+	   const size_t count = parallelCounter++;
+    #endif
+    const int i = (int)test[JSON_TEXT("i")].as_int();
+    if ((i < 0) || (i >= parallelRecords)) return;
+    if ((size_t)i != count) parallelInOrder = false;
+    parallelSeen[i] += (test[JSON_TEXT("twice")][1].as_int() == i * 2) ? 1 : 1000;
+}
+
+static void TestParallel(bool lines, bool ordered){
+    json_string all;
+    for(int i = 0; i < parallelRecords; ++i){
+	   parallelSeen[i] = 0;
+	   if (lines && (i == parallelRecords / 2)) all += JSON_TEXT("{bad\n");
+	   all += JSON_TEXT("{\"i\" : ");
+	   all += JSONNode(JSON_TEXT(""), i).as_string();
+	   all += JSON_TEXT(", \"twice\" : [\"x\", ");
+	   all += JSONNode(JSON_TEXT(""), i * 2).as_string();
+	   all += lines ? JSON_TEXT("]}\n") : JSON_TEXT("]} ");
+    }
+    parallelCounter = 0;
+    parallelInOrder = true;
+    errorCounter = 0;
+
+    JSONStream stream(ParallelCallback, errorCallback, (void*)0xDEADBEEF, lines);
+    stream.set_parallel(4, ordered, 50);
+    for(size_t i = 0; i < all.length(); i += 4096){
+	   stream << all.substr(i, 4096);
+    }
+    assertEquals(parallelCounter, (size_t)parallelRecords);
+    for(int i = 0; i < parallelRecords; ++i){
+	   assertEquals(parallelSeen[i], 1);
+    }
+    if (ordered) assertTrue(parallelInOrder);
+    assertEquals(errorCounter, lines ? 1u : 0u);
+    errorCounter = 0;
+}
 #endif  //stream
 
 
@@ -72,6 +216,121 @@ void TestSuite::TestStreams(void){
     assertEquals(5, counter);
     assertEquals(0, errorCounter);
 
+	 //however it's cut up, quotes and brackets inside of strings don't confuse it
+	 const json_string pieces(JSON_TEXT("junk {\"a\" : \"x\\\"}[\", \"c\" : \"\\\\\"} , [1, {\"b\" : \"]\"}]"));
+	 for(size_t size = 1; size < pieces.length(); ++size){
+		 pieceCounter = 0;
+		 JSONStream cut(PieceCallback, errorCallback, (void*)0xDEADBEEF);
+		 for(size_t i = 0; i < pieces.length(); i += size){
+			 cut << pieces.substr(i, size);
+		 }
+		 assertEquals(2, pieceCounter);
+	 }
+	 assertEquals(0, errorCounter);
+
+	 //objects are parsed out of the stream's own buffer, what the callback keeps can't change when it's reused
+	 {
+		 pieceCounter = 0;
+		 JSONStream many(KeepCallback, errorCallback, (void*)0xDEADBEEF);
+		 many << JSON_TEXT("{ \"first\" : \"one\" }{\"n\":2}[3] {\"unfin");
+		 assertEquals(3, pieceCounter);
+		 for(int i = 0; i < 100; ++i){
+			 many << JSON_TEXT("ished\" : 4 } [ 5, \"six\" ] {\"unfin");
+		 }
+		 many << JSON_TEXT("ished\":7}");
+		 assertEquals(204, pieceCounter);
+		 assertEquals(kept.write(), JSON_TEXT("{\"first\":\"one\"}"));
+		 kept = JSONNode();
+	 }
+	 assertEquals(0, errorCounter);
+
+	 //newline delimited, a bad line is reported and the ones after it still come through
+	 const json_string records(JSON_TEXT("{\"a\":1}\n[ 2 ]\r\n\"thr\\\"ee\"\n4.5\ntrue\nnull\n\n  \n{bad\n-7\n"));
+	 for(size_t size = 1; size <= records.length(); ++size){
+		 pieceCounter = 0;
+		 errorCounter = 0;
+		 JSONStream lines(LineCallback, errorCallback, (void*)0xDEADBEEF, true);
+		 for(size_t i = 0; i < records.length(); i += size){
+			 lines << records.substr(i, size);
+		 }
+		 assertEquals(7, pieceCounter);
+		 assertEquals(1, errorCounter);
+	 }
+	 errorCounter = 0;
+
+	 {
+		 pieceCounter = 0;
+		 batchCounter = 0;
+		 JSONStream batched(0, errorCallback, (void*)0xDEADBEEF, true);
+		 batched.set_batch_callback(BatchCallback);
+		 batched << JSON_TEXT("1\n2\n{\"three\" : 3}\n[4");
+		 assertEquals(1, batchCounter);
+		 assertEquals(3, pieceCounter);
+		 batched << JSON_TEXT("]");
+		 assertEquals(1, batchCounter);
+		 batched << JSON_TEXT("\n");
+		 assertEquals(2, batchCounter);
+		 assertEquals(4, pieceCounter);
+	 }
+	 assertEquals(0, errorCounter);
+
+	 //the elements of an array inside of a document come through one at a time, however it's cut up
+	 const json_string document(JSON_TEXT("{\"meta\" : {\"items\" : [9], \"s\" : \"]\"}, \"it\\\"ems\" : [8], \"items\" : [ {\"a\" : \"x]\"}, 2,\"thr\\\"ee\" , [1, [2]], {bad}, null ], \"after\" : [7]} "));
+	 for(size_t size = 1; size <= document.length(); ++size){
+		 pieceCounter = 0;
+		 errorCounter = 0;
+		 JSONStream items(ElementCallback, errorCallback, (void*)0xDEADBEEF);
+		 items.set_elements(JSON_TEXT("/items"));
+		 for(size_t i = 0; i < document.length(); i += size){
+			 items << document.substr(i, size);
+		 }
+		 assertEquals(5, pieceCounter);
+		 assertEquals(1, errorCounter);
+	 }
+	 errorCounter = 0;
+
+	 {
+		 pieceCounter = 0;
+		 JSONStream nested(KeepCallback, errorCallback, (void*)0xDEADBEEF);
+		 nested.set_elements(JSON_TEXT("/1/0"));
+		 nested << JSON_TEXT("[[0], [[\"first\", 5], 6], [7]] [[], [[1, 2]]]");
+		 assertEquals(4, pieceCounter);
+
+		 //somewhere the pointer doesn't lead to an array
+		 nested << JSON_TEXT("{\"1\" : [1]} [0, [{}]]");
+		 assertEquals(4, pieceCounter);
+		 assertEquals(2, errorCounter);
+		 errorCounter = 0;
+	 }
+
+	 //a huge array never has more than an element of it in memory
+	 {
+		 pieceCounter = 0;
+		 JSONStream huge(KeepCallback, errorCallback, (void*)0xDEADBEEF);
+		 huge.set_elements(JSON_TEXT(""));
+		 huge << JSON_TEXT("[");
+		 for(int i = 0; i < 1000; ++i){
+			 huge << JSON_TEXT("{\"element\" : \"") << JSONNode(JSON_TEXT(""), i).as_string() << JSON_TEXT("\"}, ");
+			 #ifdef JSON_UNIT_TEST
+				 assertTrue(huge.buffer.length() < 64);
+			 #endif
+		 }
+		 huge << JSON_TEXT("1]");
+		 assertEquals(1001, pieceCounter);
+		 #ifdef JSON_UNIT_TEST
+			 assertEquals(huge.buffer.length(), (size_t)0);
+		 #endif
+		 assertEquals(kept.write(), JSON_TEXT("{\"element\":\"0\"}"));
+		 kept = JSONNode();
+	 }
+	 assertEquals(0, errorCounter);
+
+	 //handed out to threads, the records all still come through exactly once
+	 TestParallel(false, true);
+	 TestParallel(false, false);
+	 TestParallel(true, true);
+	 TestParallel(true, false);
+
 	 #ifdef JSON_SAFE
 		 test << JSON_TEXT("{\"hello\":12keaueuataueaouhe");
 		 assertEquals(1, errorCounter);
@@ -0,0 +1,149 @@
+#include "parse.h"
+#include "../../../libjson.h"
+
+#ifdef JSON_READ_PRIORITY
+	static const json_char * sample(void){
+		return JSON_TEXT("{ \"name\" : \"libjson\",\n"
+						 "  \"version\" : 7.5,\n"
+						 "  \"tags\" : [ \"fast\", [ 1, [ 2, 3 ] ], {}, [] ],\n"
+						 "  \"nested\" : { \"deeper\" : { \"value\" : -12 } },\n"
+						 "  \"flags\" : [ true, false, null ],\n"
+						 "  \"last\" : 1e3 }");
+	}
+#endif
+
+void testJSONDocument__parse::testNavigation(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONDocument doc = libjson::parse_document(sample());
+		JSONElement root = doc.root();
+		assertEquals(root.type(), JSON_NODE);
+		assertEquals(root.size(), 6);
+		assertEquals(root.name(), JSON_TEXT(""));
+
+		assertEquals(root.at(JSON_TEXT("name")).as_string(), JSON_TEXT("libjson"));
+		assertEquals(root[JSON_TEXT("version")].type(), JSON_NUMBER);
+		assertEquals(root[JSON_TEXT("version")].as_float(), 7.5);
+		assertEquals(root[JSON_TEXT("version")].as_string(), JSON_TEXT("7.5"));
+		assertEquals(root[JSON_TEXT("last")].as_int(), 1000);
+		assertEquals(root[JSON_TEXT("nested")][JSON_TEXT("deeper")][JSON_TEXT("value")].as_int(), -12);
+
+		//the siblings after a nested container have to be found by skipping over it
+		JSONElement tags = root.at(JSON_TEXT("tags"));
+		assertEquals(tags.type(), JSON_ARRAY);
+		assertEquals(tags.size(), 4);
+		assertEquals(tags[0].as_string(), JSON_TEXT("fast"));
+		assertEquals(tags[1][1][1].as_int(), 3);
+		assertEquals(tags.at(2).type(), JSON_NODE);
+		assertTrue(tags.at(2).empty());
+		assertEquals(tags.at(3).type(), JSON_ARRAY);
+		assertTrue(tags.at(3).empty());
+		assertEquals(root.at(5).name(), JSON_TEXT("last"));
+
+		JSONElement flags = root[JSON_TEXT("flags")];
+		assertTrue(flags[0].as_bool());
+		assertFalse(flags[1].as_bool());
+		assertEquals(flags[2].type(), JSON_NULL);
+		assertEquals(flags[2].as_string(), JSON_TEXT("null"));
+
+		assertException(root.at(JSON_TEXT("missing")), std::out_of_range);
+		assertException(tags.at(4), std::out_of_range);
+
+		//copies are independent of the original
+		JSONDocument copy(doc);
+		doc = JSONDocument(JSON_TEXT("[]"));
+		assertEquals(doc.root().size(), 0);
+		assertEquals(copy.root()[JSON_TEXT("name")].as_string(), JSON_TEXT("libjson"));
+	#endif
+}
+
+void testJSONDocument__parse::testIterators(void){
+	#if defined(JSON_READ_PRIORITY) && defined(JSON_ITERATORS)
+		JSONDocument doc = libjson::parse_document(sample());
+		const json_char * names[] = { JSON_TEXT("name"), JSON_TEXT("version"), JSON_TEXT("tags"), JSON_TEXT("nested"), JSON_TEXT("flags"), JSON_TEXT("last") };
+		size_t i = 0;
+		for(JSONElement::const_iterator it = doc.root().begin(); it != doc.root().end(); ++it, ++i){
+			assertEquals(it -> name(), names[i]);
+		}
+		assertEquals(i, 6);
+
+		JSONElement tags = doc.root()[JSON_TEXT("tags")];
+		JSONElement::const_iterator it = tags.begin();
+		assertEquals((*it++).as_string(), JSON_TEXT("fast"));
+		assertEquals(it -> type(), JSON_ARRAY);
+		++it;
+		assertEquals(it -> type(), JSON_NODE);
+		++it;
+		assertTrue(it -> empty());
+		++it;
+		assertTrue(it == tags.end());
+		assertTrue(tags.at(2).begin() == tags.at(2).end());
+	#endif
+}
+
+void testJSONDocument__parse::testStrings(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONDocument doc(JSON_TEXT("{\"a\\\"b\" : \"x\\\\y\\n\\\"z\\\"\", \"u\" : \"\\u0041\\u0042\", \"plain\" : \"/#,]:\"}"));
+		JSONElement root = doc.root();
+		assertEquals(root.size(), 3);
+		assertEquals(root.at(0).name(), JSON_TEXT("a\"b"));
+		assertEquals(root[JSON_TEXT("a\"b")].as_string(), JSON_TEXT("x\\y\n\"z\""));
+		assertEquals(root[JSON_TEXT("u")].as_string(), JSON_TEXT("AB"));
+		assertEquals(root[JSON_TEXT("plain")].as_string(), JSON_TEXT("/#,]:"));
+
+		//pointer and length, nothing past the end is read
+		const json_string text(JSON_TEXT("[1,2,3]garbage"));
+		JSONDocument slice = libjson::parse_document(text.data(), 7);
+		assertEquals(slice.root().size(), 3);
+		assertEquals(slice.root()[2].as_int(), 3);
+
+		#ifdef JSON_COMMENTS
+			//comments aren't kept in a document, but they can be anywhere
+			JSONDocument commented(JSON_TEXT("//leading\n{ /* a */ \"a\" : [ 1, /* two */ 2 ] // b\n , \"b\" : true /* end */ }\n//trailing"));
+			assertEquals(commented.root().size(), 2);
+			assertEquals(commented.root()[JSON_TEXT("a")][1].as_int(), 2);
+			assertTrue(commented.root()[JSON_TEXT("b")].as_bool());
+		#endif
+	#endif
+}
+
+void testJSONDocument__parse::testToNode(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONDocument doc = libjson::parse_document(sample());
+		JSONNode node = doc.root().to_node();
+		assertEquals(node, libjson::parse(sample()));
+		assertEquals(node[JSON_TEXT("tags")][1][1][0].as_int(), 2);
+
+		JSONNode nested = doc.root()[JSON_TEXT("nested")].to_node();
+		assertEquals(nested.name(), JSON_TEXT("nested"));
+		nested[JSON_TEXT("deeper")][JSON_TEXT("value")] = 5;
+		assertEquals(nested[JSON_TEXT("deeper")][JSON_TEXT("value")].as_int(), 5);
+		assertEquals(doc.root()[JSON_TEXT("nested")][JSON_TEXT("deeper")][JSON_TEXT("value")].as_int(), -12);
+
+		//numbers keep the text they were read from
+		#ifdef JSON_WRITE_PRIORITY
+			JSONDocument numbers = libjson::parse_document(JSON_TEXT("[1.50, -3e2, 9007199254740993]"));
+			JSONNode copy = numbers.root().to_node();
+			assertEquals(copy.write(), JSON_TEXT("[1.50,-3e2,9007199254740993]"));
+			assertFloatEquals(copy[1].as_float(), -300.0f);
+		#endif
+	#endif
+}
+
+void testJSONDocument__parse::testInvalid(void){
+	#if defined(JSON_READ_PRIORITY) && !defined(JSON_DEBUG)
+		assertException(JSONDocument(JSON_TEXT("")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("hello")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("\"hello\"")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("[1,2")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("[1,2]]")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("{\"a\" 1}")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("{\"a\":1,}")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("{1:1}")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("[\"abc]")), std::invalid_argument);
+		assertException(JSONDocument(JSON_TEXT("[1}")), std::invalid_argument);
+
+		//an empty document is a single null
+		JSONDocument empty;
+		assertEquals(empty.root().type(), JSON_NULL);
+	#endif
+}
@@ -0,0 +1,16 @@
+#ifndef JSON_TESTSUITE_JSON_DOCUMENT__PARSE_H
+#define JSON_TESTSUITE_JSON_DOCUMENT__PARSE_H
+
+#include "../BaseTest.h"
+
+class testJSONDocument__parse : public BaseTest {
+public:
+	testJSONDocument__parse(const std::string & name) : BaseTest(name){}
+	void testNavigation(void);
+	void testIterators(void);
+	void testStrings(void);
+	void testToNode(void);
+	void testInvalid(void);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "parse.h"
+#include "../../Source/JSONFloat.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//the text widened into json_chars, so that the same tests work for both widths
+static json_string widen(const char * text){
+	json_string res;
+	for(; *text; ++text){
+		res += (json_char)*text;
+	}
+	return res;
+}
+
+static json_number parse(const char * text){
+	json_string wide(widen(text));
+	return JSONFloat::parse(wide.data(), wide.length());
+}
+
+//the bits have to match, not just come close
+static bool sameBits(json_number one, json_number two){
+	return std::memcmp(&one, &two, sizeof(json_number)) == 0;
+}
+
+//what the c library says the closest double is, which is only the right answer when json_number is a double
+static bool matchesLibrary(const char * text){
+	return sameBits(parse(text), (json_number)std::strtod(text, 0));
+}
+
+#if !defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+	#define JSON_TEST_DOUBLES
+#endif
+
+void testJSONFloat__parse::testSimple(void){
+	assertEquals(parse("0"), 0);
+	assertEquals(parse("-0"), 0);
+	assertEquals(parse("1"), 1);
+	assertEquals(parse("-1"), -1);
+	assertEquals(parse("123"), 123);
+	assertEquals(parse("12.5"), 12.5);
+	assertEquals(parse("-0.25"), -0.25);
+	assertEquals(parse("1e3"), 1000);
+	assertEquals(parse("1E+3"), 1000);
+	assertEquals(parse("25e-1"), 2.5);
+	assertEquals(parse("0.000"), 0);
+	assertEquals(parse("0e99999999999"), 0);
+	assertTrue(sameBits(parse("0.1"), (json_number)0.1));
+	assertTrue(sameBits(parse("-12.34"), (json_number)-12.34));
+	#ifndef JSON_STRICT
+		assertEquals(parse("+7"), 7);
+		assertEquals(parse(".5"), 0.5);
+		assertEquals(parse("5."), 5);
+	#endif
+}
+
+void testJSONFloat__parse::testExact(void){
+	#ifdef JSON_TEST_DOUBLES
+		//a naive digit by digit multiply gets every one of these wrong in the last bit
+		assertTrue(sameBits(parse("0.3"), 0.3));
+		assertTrue(sameBits(parse("2.2250738585072011e-308"), 2.2250738585072011e-308));
+		assertTrue(sameBits(parse("1.7976931348623157e308"), 1.7976931348623157e308));
+		assertTrue(sameBits(parse("9007199254740993"), 9007199254740992.0));  //half way, rounds to even
+		assertTrue(sameBits(parse("9007199254740995"), 9007199254740996.0));
+		assertTrue(sameBits(parse("1.00000000000000011102230246251565404236316680908203125"), 1.0));
+		assertTrue(sameBits(parse("1.00000000000000011102230246251565404236316680908203126"), 1.0000000000000002));
+		assertTrue(sameBits(parse("7.3177701707893310e+15"), 7.3177701707893310e+15));
+		assertTrue(sameBits(parse("4.9406564584124654e-324"), 4.9406564584124654e-324));
+		assertTrue(sameBits(parse("2.4703282292062328e-324"), 4.9406564584124654e-324));
+		assertTrue(matchesLibrary("1448997445238699"));
+		assertTrue(matchesLibrary("3.14159265358979323846"));
+		assertTrue(matchesLibrary("8.98846567431158e307"));
+		assertTrue(matchesLibrary("6.631236846766476e-316"));
+		assertTrue(matchesLibrary("1.2345678901234567e-200"));
+		assertTrue(matchesLibrary("123456789012345678e-36"));
+	#elif defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+		assertTrue(sameBits(parse("16777217"), 16777216.0f));  //half way, rounds to even
+		assertTrue(sameBits(parse("3.4028235e38"), 3.4028235e38f));
+		assertTrue(sameBits(parse("1.17549435e-38"), 1.17549435e-38f));
+		assertTrue(sameBits(parse("0.1"), 0.1f));
+	#endif
+}
+
+void testJSONFloat__parse::testLongDigits(void){
+	//more than 19 digits, the ones past that have to be looked at when they're right on an edge
+	assertEquals(parse("12345678901234567890123"), (json_number)12345678901234567890123.0);
+	assertEquals(parse("100000000000000000000000000000000000000"), (json_number)1e38);
+	assertEquals(parse("0.000000000000000000000000000000000000000000000"), 0);
+	#ifdef JSON_TEST_DOUBLES
+		assertTrue(sameBits(parse("9007199254740993.000000000000000000000001"), 9007199254740994.0));
+		assertTrue(sameBits(parse("9007199254740992.999999999999999999999999"), 9007199254740992.0));
+		assertTrue(matchesLibrary("2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180817996189898282347722858865463328355177969898199387398005390939063150356595155702263922908583924491051844359318028499365361525003193704576782492193656236698636584807570426e-324"));
+		assertTrue(matchesLibrary("0.1000000000000000055511151231257827021181583404541015625"));
+		assertTrue(matchesLibrary("1000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001"));
+	#endif
+}
+
+void testJSONFloat__parse::testLimits(void){
+	assertEquals(parse("1e-400"), 0);
+	assertEquals(parse("-1e-400"), 0);
+	assertTrue(parse("1e400") == std::numeric_limits<json_number>::infinity());
+	assertTrue(parse("-1e400") == -std::numeric_limits<json_number>::infinity());
+	assertTrue(parse("1e99999999999999999999") == std::numeric_limits<json_number>::infinity());
+	#ifdef JSON_TEST_DOUBLES
+		assertTrue(parse("1.7976931348623159e308") == std::numeric_limits<json_number>::infinity());
+		assertTrue(sameBits(parse("2.2250738585072014e-308"), std::numeric_limits<json_number>::min()));
+	#endif
+}
+
+void testJSONFloat__parse::testRandom(void){
+	#ifdef JSON_TEST_DOUBLES
+		//random bit patterns written out with as many digits as it takes to get them back, and some with less
+		unsigned long long state = 0x2545F4914F6CDD1DULL;
+		size_t wrong = 0;
+		for(unsigned int i = 0; i < 20000; ++i){
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			double value;
+			unsigned long long bits = state & 0x7FEFFFFFFFFFFFFFULL;  //no infinities or nans
+			std::memcpy(&value, &bits, sizeof(value));
+			char text[64];
+			std::snprintf(text, sizeof(text), "%.17g", value);
+			if (!matchesLibrary(text)) ++wrong;
+			std::snprintf(text, sizeof(text), "%.*e", (int)(i % 17), value);
+			if (!matchesLibrary(text)) ++wrong;
+			std::snprintf(text, sizeof(text), "%.*f", (int)(i % 9), (double)(state >> 40) / 1000.0);
+			if (!matchesLibrary(text)) ++wrong;
+		}
+		assertEquals(wrong, 0);
+	#endif
+}
+
+void testJSONFloat__parse::testNotDecimal(void){
+	#ifndef JSON_STRICT
+		//anything that isn't a plain number still gets what the c library would give
+		assertEquals(parse("0x1F"), 31);
+		assertEquals(parse(" 12"), 12);
+		assertEquals(parse("12abc"), 12);
+		assertEquals(parse("abc"), 0);
+		assertEquals(parse(""), 0);
+		assertEquals(parse("1e"), 1);
+	#endif
+}
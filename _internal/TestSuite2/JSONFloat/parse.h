@@ -0,0 +1,17 @@
+#ifndef JSON_TESTSUITE_JSON_FLOAT__PARSE_H
+#define JSON_TESTSUITE_JSON_FLOAT__PARSE_H
+
+#include "../BaseTest.h"
+
+class testJSONFloat__parse : public BaseTest {
+public:
+	testJSONFloat__parse(const std::string & name) : BaseTest(name){}
+	void testSimple(void);
+	void testExact(void);
+	void testLongDigits(void);
+	void testLimits(void);
+	void testRandom(void);
+	void testNotDecimal(void);
+};
+
+#endif
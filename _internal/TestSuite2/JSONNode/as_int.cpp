@@ -0,0 +1,65 @@
+#include "as_int.h"
+#include "../../../libjson.h"
+
+/**
+ *	Test that whole numbers in the text are kept exactly, not rounded to a double
+ */
+void testJSONNode__as_int::testParsed(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONNode arr(libjson::parse(JSON_TEXT("[9007199254740993, -9223372036854775807, 12, -0, 1.5, 1e3, 18446744073709551615]")));
+		assertEquals(arr.size(), 7);
+		if (sizeof(json_int_t) >= 8){
+			assertTrue(arr[0].as_int() == (json_int_t)9007199254740993LL);
+			assertTrue(arr[1].as_int() == (json_int_t)-9223372036854775807LL);
+		}
+		assertEquals(arr[2].as_int(), 12);
+		assertEquals(arr[3].as_int(), 0);
+		assertEquals(arr[5].as_int(), 1000);
+		assertFloatEquals(arr[2].as_float(), 12.0f);
+		assertFloatEquals(arr[4].as_float(), 1.5f);
+		assertTrue(arr[6].as_float() > (json_number)1e19);
+		assertTrue(arr[6].as_float() < (json_number)2e19);
+
+		#ifndef JSON_LESS_MEMORY
+			assertEquals(arr[0].as_string(), JSON_TEXT("9007199254740993"));
+		#endif
+	#endif
+}
+
+/**
+ *	Test that setting a 64 bit integer gives it back and writes it exactly
+ */
+void testJSONNode__as_int::testSet(void){
+	if (sizeof(json_int_t) >= 8 && sizeof(long) >= 8){
+		JSONNode big(JSON_TEXT("id"), 9007199254740993LL);
+		assertTrue(big.as_int() == (json_int_t)9007199254740993LL);
+		#ifdef JSON_WRITE_PRIORITY
+			JSONNode arr(JSON_ARRAY);
+			arr.push_back(big);
+			assertEquals(arr.write(), JSON_TEXT("[9007199254740993]"));
+		#endif
+
+		JSONNode negative(JSON_TEXT("id"), -9007199254740993LL);
+		assertTrue(negative.as_int() == (json_int_t)-9007199254740993LL);
+
+		big = 1.5;
+		assertFloatEquals(big.as_float(), 1.5f);
+		big = 7;
+		assertEquals(big.as_int(), 7);
+	}
+	JSONNode small(JSON_TEXT("n"), (unsigned char)200);
+	assertEquals(small.as_int(), 200);
+}
+
+/**
+ *	Test that integers that would be the same double aren't equal
+ */
+void testJSONNode__as_int::testEquality(void){
+	JSONNode one(JSON_TEXT(""), 9007199254740993LL);
+	JSONNode two(JSON_TEXT(""), 9007199254740992LL);
+	assertTrue(one != two);
+	assertTrue(one == JSONNode(JSON_TEXT(""), 9007199254740993LL));
+	assertTrue(JSONNode(JSON_TEXT(""), 12) == JSONNode(JSON_TEXT(""), 12.0));
+	assertTrue(JSONNode(JSON_TEXT(""), 18446744073709551615ULL) == JSONNode(JSON_TEXT(""), 18446744073709551615ULL));
+	assertTrue(JSONNode(JSON_TEXT(""), 18446744073709551615ULL) != JSONNode(JSON_TEXT(""), 18446744073709551614ULL));
+}
@@ -0,0 +1,14 @@
+#ifndef JSON_TESTSUITE_JSON_NODE__AS_INT_H
+#define JSON_TESTSUITE_JSON_NODE__AS_INT_H
+
+#include "../BaseTest.h"
+
+class testJSONNode__as_int : public BaseTest {
+public:
+	testJSONNode__as_int(const std::string & name) : BaseTest(name){}
+	void testParsed(void);
+	void testSet(void);
+	void testEquality(void);
+};
+
+#endif
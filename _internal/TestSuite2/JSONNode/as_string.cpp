@@ -0,0 +1,61 @@
+#include "as_string.h"
+#include "../../../libjson.h"
+
+/**
+ *	Test that setting a number over and over doesn't make any text until it's asked for
+ */
+void testJSONNode__as_string::testDeferred(void){
+	JSONNode counter(JSON_TEXT("count"), 0);
+	for(int i = 1; i <= 1000; ++i){
+		counter = counter.as_int() + 1;
+		#ifdef JSON_UNIT_TEST
+			assertTrue(counter.internal -> _string.empty());
+		#endif
+	}
+	assertEquals(counter.as_int(), 1000);
+	assertEquals(counter.as_string(), JSON_TEXT("1000"));
+
+	counter = -42;
+	assertEquals(counter.as_string(), JSON_TEXT("-42"));
+	counter = 2.5;
+	assertEquals(counter.as_string(), JSON_TEXT("2.5"));
+	counter = 18446744073709551615ULL;
+	assertEquals(counter.as_string(), JSON_TEXT("18446744073709551615"));
+
+	#ifdef JSON_WRITE_PRIORITY
+		JSONNode obj(JSON_NODE);
+		obj.push_back(JSONNode(JSON_TEXT("a"), 1));
+		obj.push_back(JSONNode(JSON_TEXT("b"), -0.25));
+		obj.push_back(JSONNode(JSON_TEXT("c"), true));
+		assertEquals(obj.write(), JSON_TEXT("{\"a\":1,\"b\":-0.25,\"c\":true}"));
+		obj[0] = 2;
+		assertEquals(obj.write(), JSON_TEXT("{\"a\":2,\"b\":-0.25,\"c\":true}"));
+	#endif
+}
+
+/**
+ *	Test that a float is still written with only the digits that a float has
+ */
+void testJSONNode__as_string::testFloatDigits(void){
+	JSONNode single(JSON_TEXT(""), 13.7f);
+	assertEquals(single.as_string(), JSON_TEXT("13.7"));
+	#ifdef JSON_WRITE_PRIORITY
+		JSONNode arr(JSON_ARRAY);
+		arr.push_back(single);
+		arr.push_back(JSONNode(JSON_TEXT(""), 0.1f));
+		assertEquals(arr.write(), JSON_TEXT("[13.7,0.1]"));
+	#endif
+}
+
+/**
+ *	Test that parsed numbers are written the way they were read until they're changed
+ */
+void testJSONNode__as_string::testParsed(void){
+	#if defined(JSON_READ_PRIORITY) && defined(JSON_WRITE_PRIORITY)
+		JSONNode arr(libjson::parse(JSON_TEXT("[1.50, 12, -3e2]")));
+		assertEquals(arr.write(), JSON_TEXT("[1.50,12,-3e2]"));
+		assertFloatEquals(arr[2].as_float(), -300.0f);
+		arr[1] = 13;
+		assertEquals(arr.write(), JSON_TEXT("[1.50,13,-3e2]"));
+	#endif
+}
@@ -0,0 +1,14 @@
+#ifndef JSON_TESTSUITE_JSON_NODE__AS_STRING_H
+#define JSON_TESTSUITE_JSON_NODE__AS_STRING_H
+
+#include "../BaseTest.h"
+
+class testJSONNode__as_string : public BaseTest {
+public:
+	testJSONNode__as_string(const std::string & name) : BaseTest(name){}
+	void testDeferred(void);
+	void testFloatDigits(void);
+	void testParsed(void);
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "preparse_parallel.h"
+#include "../../../libjson.h"
+
+#if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+	//a few hundred records that all look a little different, with nesting and strings that need fixing
+	static json_string records(void){
+		json_string res(JSON_TEXT("["));
+		for(int i = 0; i < 300; ++i){
+			if (i) res += JSON_TEXT(",\n");
+			const json_string num(NumberToString::_itoa<long>((long)i));
+			res += JSON_TEXT("{\"id\":") + num + JSON_TEXT(", \"name\":\"record \\\"") + num + JSON_TEXT("\\\"\", \"tags\":[\"a\",\"b\",[") + num + JSON_TEXT("]], ");
+			res += JSON_TEXT("\"nested\":{\"deep\":{\"ok\":true, \"none\":null}}, \"empty\":{}, \"list\":[]}");
+		}
+		res += JSON_TEXT("]");
+		return res;
+	}
+#endif
+
+void testJSONNode__preparse_parallel::testArray(void){
+	#if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+		const json_string text(records());
+		JSONNode serial(libjson::parse(text));
+		serial.preparse();
+
+		JSONNode parallel(libjson::parse(text));
+		parallel.preparse_parallel(4);
+		assertEquals(parallel.size(), 300);
+		assertEquals(parallel[299][JSON_TEXT("id")].as_int(), 299);
+		assertEquals(parallel[17][JSON_TEXT("name")].as_string(), JSON_TEXT("record \"17\""));
+		assertEquals(parallel[5][JSON_TEXT("tags")][2][0].as_int(), 5);
+		assertTrue(parallel[42][JSON_TEXT("nested")][JSON_TEXT("deep")][JSON_TEXT("ok")].as_bool());
+		assertEquals(parallel.write(), serial.write());
+		assertTrue(parallel == serial);
+
+		//every processor, and through libjson
+		JSONNode all(libjson::parse_parallel(text));
+		assertEquals(all.write(), serial.write());
+		JSONNode some(libjson::parse_parallel(text.data(), text.length(), 3));
+		assertEquals(some.write(), serial.write());
+	#endif
+}
+
+void testJSONNode__preparse_parallel::testObject(void){
+	#if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+		const json_string text(JSON_TEXT("{\"a\":") + records() + JSON_TEXT(", \"b\":[1,2,3], \"c\":\"str\", \"d\":{\"e\":[{}]}, \"f\":7}"));
+		JSONNode serial(libjson::parse(text));
+		serial.preparse();
+		JSONNode parallel(libjson::parse_parallel(text, 8));
+		assertEquals(parallel.size(), 5);
+		assertEquals(parallel.write(), serial.write());
+		assertEquals(parallel[JSON_TEXT("a")][123][JSON_TEXT("id")].as_int(), 123);
+		assertEquals(parallel[JSON_TEXT("c")].as_string(), JSON_TEXT("str"));
+		assertEquals(parallel[JSON_TEXT("f")].as_int(), 7);
+	#endif
+}
+
+void testJSONNode__preparse_parallel::testInsitu(void){
+	#if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+		//the children borrow the caller's buffer, each worker needs its own copy
+		const json_string text(records());
+		json_auto<json_char> buf(text.length() + 1);
+		std::memcpy(buf.ptr, text.c_str(), (text.length() + 1) * sizeof(json_char));
+		JSONNode parallel(libjson::parse_insitu(buf.ptr, text.length()));
+		parallel.preparse_parallel(4);
+
+		JSONNode serial(libjson::parse(text));
+		serial.preparse();
+		assertEquals(parallel.write(), serial.write());
+	#endif
+}
+
+void testJSONNode__preparse_parallel::testSmall(void){
+	#if !defined(JSON_PREPARSE) && defined(JSON_READ_PRIORITY)
+		//fewer children than threads, or none at all
+		JSONNode two(libjson::parse(JSON_TEXT("[{\"a\":1},[2]]")));
+		two.preparse_parallel(16);
+		assertEquals(two.write(), JSON_TEXT("[{\"a\":1},[2]]"));
+
+		JSONNode empty(libjson::parse(JSON_TEXT("[]")));
+		empty.preparse_parallel(4);
+		assertEquals(empty.size(), 0);
+
+		JSONNode one(libjson::parse(JSON_TEXT("{\"x\":[1,2]}")));
+		one.preparse_parallel(1);
+		assertEquals(one[JSON_TEXT("x")][1].as_int(), 2);
+	#endif
+}
@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_NODE__PREPARSE_PARALLEL_H
+#define JSON_TESTSUITE_JSON_NODE__PREPARSE_PARALLEL_H
+
+#include "../BaseTest.h"
+
+class testJSONNode__preparse_parallel : public BaseTest {
+public:
+	testJSONNode__preparse_parallel(const std::string & name) : BaseTest(name){}
+	void testArray(void);
+	void testObject(void);
+	void testInsitu(void);
+	void testSmall(void);
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "next.h"
+#include "../../../libjson.h"
+
+void testJSONReader__next::testTokens(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONReader reader(JSON_TEXT("{ \"a\" : [ 1, -2.5e1, true, false, null ],\n\t\"b\" : { \"c\" : \"d\", \"e\" : {} }, \"f\" : [] }"));
+		assertEquals(reader.next(), JSONReader::start_object);
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.read_key(), JSON_TEXT("a"));
+		assertEquals(reader.next(), JSONReader::start_array);
+		assertEquals(reader.depth(), 1);
+		assertEquals(reader.next(), JSONReader::number);
+		assertEquals(reader.depth(), 2);
+		assertEquals(reader.read_number(), 1);
+		assertEquals(reader.next(), JSONReader::number);
+		assertEquals(reader.read_number(), -25);
+		assertEquals(reader.next(), JSONReader::boolean);
+		assertTrue(reader.read_bool());
+		assertEquals(reader.next(), JSONReader::boolean);
+		assertFalse(reader.read_bool());
+		assertEquals(reader.next(), JSONReader::null_value);
+		assertEquals(reader.next(), JSONReader::end_array);
+		assertEquals(reader.next(), JSONReader::key);
+		assertTrue(reader.key_equals(JSON_TEXT("b")));
+		assertFalse(reader.key_equals(JSON_TEXT("bb")));
+		assertEquals(reader.next(), JSONReader::start_object);
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.next(), JSONReader::string);
+		assertEquals(reader.read_string(), JSON_TEXT("d"));
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.next(), JSONReader::start_object);
+		assertEquals(reader.next(), JSONReader::end_object);
+		assertEquals(reader.next(), JSONReader::end_object);
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.next(), JSONReader::start_array);
+		assertEquals(reader.next(), JSONReader::end_array);
+		assertEquals(reader.next(), JSONReader::end_object);
+		assertEquals(reader.current(), JSONReader::end_object);
+		assertEquals(reader.next(), JSONReader::end_of_input);
+		assertEquals(reader.next(), JSONReader::end_of_input);
+
+		//pointer and length, the rest isn't looked at
+		const json_string text(JSON_TEXT("[7]]]"));
+		JSONReader part(text.data(), 3);
+		assertEquals(part.next(), JSONReader::start_array);
+		assertEquals(part.next(), JSONReader::number);
+		assertEquals(part.read_number(), 7);
+		assertEquals(part.next(), JSONReader::end_array);
+		assertEquals(part.next(), JSONReader::end_of_input);
+	#endif
+}
+
+void testJSONReader__next::testSkip(void){
+	#ifdef JSON_READ_PRIORITY
+		//only two members of each object are wanted, everything else gets jumped over
+		JSONReader reader(JSON_TEXT("[{\"id\":1,\"junk\":{\"a\":[1,2,{\"b\":\"]}\"}]},\"bytes\":10,\"more\":[[],{}]},")
+						  JSON_TEXT(" {\"junk\":\"{[\", \"bytes\":32, \"id\":2}, {\"id\":3, \"other\":null, \"bytes\":0.5}]"));
+		json_number ids = 0, bytes = 0;
+		int objects = 0;
+		assertEquals(reader.next(), JSONReader::start_array);
+		while (reader.next() == JSONReader::start_object){
+			++objects;
+			while (reader.next() == JSONReader::key){
+				if (reader.key_equals(JSON_TEXT("id"))){
+					reader.next();
+					ids += reader.read_number();
+				} else if (reader.key_equals(JSON_TEXT("bytes"))){
+					reader.next();
+					bytes += reader.read_number();
+				} else {
+					reader.skip_value();
+				}
+			}
+			assertEquals(reader.current(), JSONReader::end_object);
+		}
+		assertEquals(reader.current(), JSONReader::end_array);
+		assertEquals(reader.next(), JSONReader::end_of_input);
+		assertEquals(objects, 3);
+		assertEquals(ids, 6);
+		assertEquals(bytes, 42.5);
+
+		//skipping on the value itself, and on something that isn't a container
+		JSONReader values(JSON_TEXT("[[1,[2]],3,{\"x\":[]},4]"));
+		assertEquals(values.next(), JSONReader::start_array);
+		assertEquals(values.next(), JSONReader::start_array);
+		values.skip_value();
+		assertEquals(values.next(), JSONReader::number);
+		values.skip_value();
+		assertEquals(values.read_number(), 3);
+		assertEquals(values.next(), JSONReader::start_object);
+		values.skip_value();
+		assertEquals(values.next(), JSONReader::number);
+		assertEquals(values.read_number(), 4);
+		assertEquals(values.next(), JSONReader::end_array);
+		assertEquals(values.next(), JSONReader::end_of_input);
+
+		#ifndef JSON_STRICT
+			JSONReader comments(JSON_TEXT("[{\"a\":[1 /* ]] */, 2 # }\n]}, //]\n 5]"));
+			assertEquals(comments.next(), JSONReader::start_array);
+			assertEquals(comments.next(), JSONReader::start_object);
+			comments.skip_value();
+			assertEquals(comments.next(), JSONReader::number);
+			assertEquals(comments.read_number(), 5);
+			assertEquals(comments.next(), JSONReader::end_array);
+			assertEquals(comments.next(), JSONReader::end_of_input);
+		#endif
+	#endif
+}
+
+void testJSONReader__next::testStrings(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONReader reader(JSON_TEXT("{\"a\\\"b\":\"x\\\\y\\n\\\"z\\\"\",\"u\":\"\\u0041\\u0042\",\"p\":\"/#,]:\"}"));
+		assertEquals(reader.next(), JSONReader::start_object);
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.read_key(), JSON_TEXT("a\"b"));
+		assertTrue(reader.key_equals(JSON_TEXT("a\"b")));
+		assertEquals(reader.next(), JSONReader::string);
+		assertEquals(reader.read_string(), JSON_TEXT("x\\y\n\"z\""));
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.next(), JSONReader::string);
+		assertEquals(reader.read_string(), JSON_TEXT("AB"));
+		assertEquals(reader.next(), JSONReader::key);
+		assertEquals(reader.next(), JSONReader::string);
+		assertEquals(reader.read_string(), JSON_TEXT("/#,]:"));
+		assertEquals(reader.next(), JSONReader::end_object);
+		assertEquals(reader.next(), JSONReader::end_of_input);
+	#endif
+}
+
+void testJSONReader__next::testInvalid(void){
+	#ifdef JSON_READ_PRIORITY
+		#define assertInvalid(text, tokens)\
+			{\
+				JSONReader reader(JSON_TEXT(text));\
+				for(int i = 0; i < tokens; ++i) reader.next();\
+				assertEquals(reader.next(), JSONReader::invalid);\
+				assertEquals(reader.next(), JSONReader::invalid);\
+			}
+		assertInvalid("", 0);
+		assertInvalid("[1,2", 3);
+		assertInvalid("[1,2]]", 4);
+		assertInvalid("{\"a\" 1}", 2);
+		assertInvalid("{1:1}", 1);
+		assertInvalid("[\"abc]", 1);
+		assertInvalid("[1}", 2);
+		assertInvalid("[tru]", 1);
+		assertInvalid("[1,]", 2);
+		assertInvalid("[x]", 1);
+		#undef assertInvalid
+
+		//a container that never ends can't be skipped
+		JSONReader reader(JSON_TEXT("[[1,2"));
+		reader.next();
+		reader.next();
+		reader.skip_value();
+		assertEquals(reader.current(), JSONReader::invalid);
+	#endif
+}
@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_READER__NEXT_H
+#define JSON_TESTSUITE_JSON_READER__NEXT_H
+
+#include "../BaseTest.h"
+
+class testJSONReader__next : public BaseTest {
+public:
+	testJSONReader__next(const std::string & name) : BaseTest(name){}
+	void testTokens(void);
+	void testSkip(void);
+	void testStrings(void);
+	void testInvalid(void);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "parse.h"
+#include "../../../libjson.h"
+
+#ifdef JSON_READ_PRIORITY
+	//writes every event into a string so that the order can be checked
+	struct Recorder {
+		Recorder(void) : log(), limit(0xFFFF){}
+		bool start_object(void){ return add(JSON_TEXT("{")); }
+		bool key(const json_char * name, size_t length){ return add(json_string(name, length) + JSON_TEXT(":")); }
+		bool end_object(void){ return add(JSON_TEXT("}")); }
+		bool start_array(void){ return add(JSON_TEXT("[")); }
+		bool end_array(void){ return add(JSON_TEXT("]")); }
+		bool string(const json_char * value, size_t length){ return add(JSON_TEXT("s(") + json_string(value, length) + JSON_TEXT(")")); }
+		bool number(json_number value){ return add(JSON_TEXT("n(") + NumberToString::_itoa<long>((long)value) + JSON_TEXT(")")); }
+		bool boolean(bool value){ return add(value ? JSON_TEXT("t") : JSON_TEXT("f")); }
+		bool null(void){ return add(JSON_TEXT("null")); }
+
+		bool add(const json_string & event){
+			if (limit-- == 0) return false;
+			log += event;
+			log += JSON_TEXT(' ');
+			return true;
+		}
+		json_string log;
+		size_t limit;
+	};
+
+	//only adds up one field, the way that the log aggregation does
+	struct Summer {
+		Summer(void) : total(0), wanted(false){}
+		bool start_object(void){ return true; }
+		bool key(const json_char * name, size_t length){
+			wanted = json_string(name, length) == JSON_TEXT("bytes");
+			return true;
+		}
+		bool end_object(void){ return true; }
+		bool start_array(void){ return true; }
+		bool end_array(void){ return true; }
+		bool string(const json_char *, size_t){ return true; }
+		bool number(json_number value){
+			if (wanted) total += value;
+			return true;
+		}
+		bool boolean(bool){ return true; }
+		bool null(void){ return true; }
+		json_number total;
+		bool wanted;
+	};
+#endif
+
+void testJSONSax__parse::testEvents(void){
+	#ifdef JSON_READ_PRIORITY
+		Recorder rec;
+		assertTrue(libjson::parse_sax(JSON_TEXT("{ \"a\" : [ 1, -2.5e1, true, false, null ],\n\t\"b\" : { \"c\" : \"d\", \"e\" : {} }, \"f\" : [] }"), rec));
+		assertEquals(rec.log, JSON_TEXT("{ a: [ n(1) n(-25) t f null ] b: { c: s(d) e: { } } f: [ ] } "));
+
+		Summer sum;
+		assertTrue(libjson::parse_sax(JSON_TEXT("[{\"bytes\":10,\"path\":\"/\"},{\"path\":\"/x\",\"bytes\":32,\"other\":5},{\"bytes\":0.5}]"), sum));
+		assertEquals(sum.total, 42.5);
+
+		//pointer and length, the rest isn't looked at
+		const json_string text(JSON_TEXT("[1,2]]]"));
+		Recorder part;
+		assertTrue(libjson::parse_sax(text.data(), 5, part));
+		assertEquals(part.log, JSON_TEXT("[ n(1) n(2) ] "));
+	#endif
+}
+
+void testJSONSax__parse::testStrings(void){
+	#ifdef JSON_READ_PRIORITY
+		Recorder rec;
+		assertTrue(libjson::parse_sax(JSON_TEXT("{\"a\\\"b\":\"x\\\\y\\n\\\"z\\\"\",\"u\":\"\\u0041\\u0042\",\"p\":\"/#,]:\"}"), rec));
+		assertEquals(rec.log, JSON_TEXT("{ a\"b: s(x\\y\n\"z\") u: s(AB) p: s(/#,]:) } "));
+	#endif
+}
+
+void testJSONSax__parse::testStop(void){
+	#ifdef JSON_READ_PRIORITY
+		Recorder rec;
+		rec.limit = 3;
+		assertFalse(libjson::parse_sax(JSON_TEXT("[1,2,3,4]"), rec));
+		assertEquals(rec.log, JSON_TEXT("[ n(1) n(2) "));
+	#endif
+}
+
+void testJSONSax__parse::testInvalid(void){
+	#ifdef JSON_READ_PRIORITY
+		Recorder rec;
+		assertFalse(libjson::parse_sax(JSON_TEXT(""), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("\"hello\""), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[1,2"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[1,2]]"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("{\"a\" 1}"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("{1:1}"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[\"abc]"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[1}"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[tru]"), rec));
+		assertFalse(libjson::parse_sax(JSON_TEXT("[1.2.3]"), rec));
+	#endif
+}
@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_SAX__PARSE_H
+#define JSON_TESTSUITE_JSON_SAX__PARSE_H
+
+#include "../BaseTest.h"
+
+class testJSONSax__parse : public BaseTest {
+public:
+	testJSONSax__parse(const std::string & name) : BaseTest(name){}
+	void testEvents(void);
+	void testStrings(void);
+	void testStop(void);
+	void testInvalid(void);
+};
+
+#endif
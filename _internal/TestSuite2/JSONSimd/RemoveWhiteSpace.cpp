@@ -0,0 +1,96 @@
+#include "RemoveWhiteSpace.h"
+#include "../../Source/JSONSimd.h"
+#include "../../Source/JSONWorker.h"
+
+/*
+ *	The kernels work in blocks of 16 or 32 characters, so everything here is
+ *	repeated at many different lengths to make sure that the interesting
+ *	characters land at every position in a block, and in the leftovers at the end
+ */
+
+static json_string repeated(json_char ch, size_t count){
+	return json_string(count, ch);
+}
+
+void testJSONSimd__RemoveWhiteSpace::testWhiteSpace(void){
+	#ifdef JSON_SIMD
+		UnitTest::echo_(std::string("SIMD level: ") + JSONSimd::level());
+	#endif
+	for(size_t i = 0; i < 70; ++i){
+		json_string json = JSON_TEXT("{\n");
+		json += repeated(JSON_TEXT(' '), i);
+		json += JSON_TEXT("\"key\"\t:\r\n");
+		json += repeated(JSON_TEXT('\t'), i % 7);
+		json += JSON_TEXT("[");
+		json += repeated(JSON_TEXT('1'), i);
+		json += JSON_TEXT(" , true,null ]");
+		json += repeated(JSON_TEXT('\n'), i);
+		json += JSON_TEXT("}");
+
+		json_string expected = JSON_TEXT("{\"key\":[");
+		expected += repeated(JSON_TEXT('1'), i);
+		expected += JSON_TEXT(",true,null]}");
+		assertEquals(JSONWorker::RemoveWhiteSpaceAndComments(json, false), expected);
+	}
+}
+
+void testJSONSimd__RemoveWhiteSpace::testStrings(void){
+	for(size_t i = 0; i < 70; ++i){
+		//white space inside of strings is kept, escaped quotes are swapped for \1
+		json_string json = JSON_TEXT("[ \"");
+		json += repeated(JSON_TEXT(' '), i);
+		json += JSON_TEXT("a\\\"b\\\\");
+		json += repeated(JSON_TEXT('x'), i);
+		json += JSON_TEXT("\" , \"/#\"\t]");
+
+		json_string expected = JSON_TEXT("[\"");
+		expected += repeated(JSON_TEXT(' '), i);
+		expected += JSON_TEXT("a\\\1b\\\\");
+		expected += repeated(JSON_TEXT('x'), i);
+		expected += JSON_TEXT("\",\"/#\"]");
+		assertEquals(JSONWorker::RemoveWhiteSpaceAndComments(json, true), expected);
+
+		expected[i + 4] = JSON_TEXT('\"');
+		assertEquals(JSONWorker::RemoveWhiteSpaceAndComments(json, false), expected);
+	}
+}
+
+void testJSONSimd__RemoveWhiteSpace::testComments(void){
+	#ifndef JSON_STRICT
+		for(size_t i = 0; i < 70; ++i){
+			json_string json = JSON_TEXT("{ /* ");
+			json += repeated(JSON_TEXT('c'), i);
+			json += JSON_TEXT(" */ \"a\" : 1 , # ");
+			json += repeated(JSON_TEXT(' '), i);
+			json += JSON_TEXT("\n  \"b\" : 2 // \"not a string\n}");
+			assertEquals(JSONWorker::RemoveWhiteSpaceAndComments(json, false), JSON_TEXT("{\"a\":1,\"b\":2}"));
+
+			#if defined(JSON_COMMENTS) && defined(JSON_READ_PRIORITY)
+				size_t len;
+				json_auto<json_char> kept;
+				kept.set(JSONWorker::RemoveWhiteSpace(json, len, false));
+				json_string expected = JSON_TEXT("{# ");
+				expected += repeated(JSON_TEXT('c'), i);
+				expected += JSON_TEXT(" #\"a\":1,# ");
+				expected += repeated(JSON_TEXT(' '), i);
+				expected += JSON_TEXT("#\"b\":2# \"not a string#}");
+				assertEquals(json_string(kept.ptr, len), expected);
+			#endif
+		}
+	#endif
+}
+
+void testJSONSimd__RemoveWhiteSpace::testHighCharacters(void){
+	#ifndef JSON_UNICODE
+		for(size_t i = 0; i < 70; ++i){
+			//utf-8 inside of strings is copied untouched
+			json_string json = JSON_TEXT("[ \"");
+			json += repeated(JSON_TEXT('z'), i);
+			json += JSON_TEXT("\xC3\xA9\xE2\x82\xAC\t\" ]");
+			json_string expected = JSON_TEXT("[\"");
+			expected += repeated(JSON_TEXT('z'), i);
+			expected += JSON_TEXT("\xC3\xA9\xE2\x82\xAC\t\"]");
+			assertEquals(JSONWorker::RemoveWhiteSpaceAndComments(json, false), expected);
+		}
+	#endif
+}
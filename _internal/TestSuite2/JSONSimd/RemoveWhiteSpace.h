@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_SIMD__REMOVE_WHITE_SPACE_H
+#define JSON_TESTSUITE_JSON_SIMD__REMOVE_WHITE_SPACE_H
+
+#include "../BaseTest.h"
+
+class testJSONSimd__RemoveWhiteSpace : public BaseTest {
+public:
+	testJSONSimd__RemoveWhiteSpace(const std::string & name) : BaseTest(name){}
+	void testWhiteSpace(void);
+	void testStrings(void);
+	void testComments(void);
+	void testHighCharacters(void);
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "newIndex.h"
+#include "../../Source/JSONStructuralIndex.h"
+#include "../../../libjson.h"
+
+/**
+ *	Make sure every structural character gets an entry and that the
+ *	opening brackets know where they are closed
+ */
+void testJSONStructuralIndex__newIndex::testMatching(void){
+	#ifdef JSON_STRUCTURAL_INDEX
+		const json_string json(JSON_TEXT("{\"a\":[1,{\"b\":2}],\"c\":3}"));
+		JSONStructuralIndex * index = JSONStructuralIndex::newIndex(json.data(), json.length());
+		assertNotNull(index);
+		if (index != 0){
+			assertEquals(index -> size(), 11);
+			assertEquals(index -> position(0), 0);  //{
+			assertEquals(index -> match(0), 10);
+			assertEquals(index -> position(1), 4);  //:
+			assertEquals(index -> position(2), 5);  //[
+			assertEquals(index -> match(2), 7);
+			assertEquals(index -> position(4), 8);  //{
+			assertEquals(index -> match(4), 6);
+			assertEquals(index -> position(7), 15);  //]
+			assertEquals(index -> position(10), json.length() - 1);
+			JSONStructuralIndex::decRef(index);
+			assertNull(index);
+		}
+	#endif
+}
+
+/**
+ *	Brackets and commas inside of strings are not structural, even with escaped quotes
+ */
+void testJSONStructuralIndex__newIndex::testStrings(void){
+	#ifdef JSON_STRUCTURAL_INDEX
+		const json_string json(JSON_TEXT("[\"[,\\\"{\",\"}\\\\\",:]"));
+		JSONStructuralIndex * index = JSONStructuralIndex::newIndex(json.data(), json.length());
+		assertNotNull(index);
+		if (index != 0){
+			assertEquals(index -> size(), 5);
+			assertEquals(index -> match(0), 4);
+			assertEquals(index -> position(1), 8);
+			assertEquals(index -> position(2), 14);
+			assertEquals(index -> position(3), 15);
+			JSONStructuralIndex::decRef(index);
+		}
+	#endif
+}
+
+void testJSONStructuralIndex__newIndex::testUnbalanced(void){
+	#ifdef JSON_STRUCTURAL_INDEX
+		const json_char * bad[] = {
+			JSON_TEXT("{"),
+			JSON_TEXT("[1,2]]"),
+			JSON_TEXT("[1,2}"),
+			JSON_TEXT("{\"a\":[}]"),
+			JSON_TEXT("[\"abc]")
+		};
+		for(size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i){
+			const json_string json(bad[i]);
+			assertNull(JSONStructuralIndex::newIndex(json.data(), json.length()));
+		}
+	#endif
+}
+
+/**
+ *	Children of an indexed parent are fetched using the parent's index,
+ *	so deep, lazily fetched documents have to come out exactly the same
+ */
+void testJSONStructuralIndex__newIndex::testParse(void){
+	#ifdef JSON_READ_PRIORITY
+		JSONNode node = libjson::parse(JSON_TEXT("{\"a\" : [1, {\"b\" : [[], {}, [true]]}, \"x,]\"], \"c\" : {\"d\" : {\"e\" : null}}, \"f\" : \"g\"}"));
+		assertEquals(node.size(), 3);
+		assertEquals(node[0].name(), JSON_TEXT("a"));
+		assertEquals(node[0].size(), 3);
+		assertEquals(node[0][0].as_int(), 1);
+		assertEquals(node[0][1][0].name(), JSON_TEXT("b"));
+		assertEquals(node[0][1][0].size(), 3);
+		assertEquals(node[0][1][0][0].size(), 0);
+		assertEquals(node[0][1][0][1].type(), JSON_NODE);
+		assertEquals(node[0][1][0][1].size(), 0);
+		assertTrue(node[0][1][0][2][0].as_bool());
+		assertEquals(node[0][2].as_string(), JSON_TEXT("x,]"));
+		assertEquals(node[1][0][0].type(), JSON_NULL);
+		assertEquals(node[1][0][0].name(), JSON_TEXT("e"));
+		assertEquals(node[2].as_string(), JSON_TEXT("g"));
+
+		//copies made before fetching share the index
+		JSONNode deep = libjson::parse(JSON_TEXT("[[[1,2],[3]],[4]]"));
+		JSONNode inner = deep[0];
+		JSONNode copy = inner;
+		assertEquals(copy.size(), 2);
+		assertEquals(copy[1][0].as_int(), 3);
+		assertEquals(inner[0][1].as_int(), 2);
+		assertEquals(deep[1][0].as_int(), 4);
+		assertEquals(deep.write(), JSON_TEXT("[[[1,2],[3]],[4]]"));
+	#endif
+}
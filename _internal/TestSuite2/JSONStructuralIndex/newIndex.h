@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_STRUCTURAL_INDEX__NEW_INDEX_H
+#define JSON_TESTSUITE_JSON_STRUCTURAL_INDEX__NEW_INDEX_H
+
+#include "../BaseTest.h"
+
+class testJSONStructuralIndex__newIndex : public BaseTest {
+public:
+	testJSONStructuralIndex__newIndex(const std::string & name) : BaseTest(name){}
+	void testMatching(void);
+	void testStrings(void);
+	void testUnbalanced(void);
+	void testParse(void);
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include "isValid.h"
+#include "../../Source/JSONUtf8.h"
+#include "../../../libjson.h"
+
+/*
+ *	Ascii is skipped a block at a time, so everything is tried behind
+ *	different amounts of it to land the interesting bytes all over a block
+ */
+
+#ifndef JSON_UNICODE
+	static bool valid(const char * bytes, size_t pad){
+		std::string text(pad, 'a');
+		text += bytes;
+		text += std::string(pad % 9, 'z');
+		return JSONUtf8::isValid(text.data(), text.length());
+	}
+#endif
+
+void testJSONUtf8__isValid::testAscii(void){
+	#ifndef JSON_UNICODE
+		for(size_t i = 0; i < 40; ++i){
+			assertTrue(valid("", i));
+			assertTrue(valid("{\"key\":[1,true,null]}", i));
+		}
+		assertTrue(JSONUtf8::isValid(0, 0));
+		const char withNull[] = "a\0b";
+		assertTrue(JSONUtf8::isValid(withNull, 3));
+	#endif
+}
+
+void testJSONUtf8__isValid::testMultiByte(void){
+	#ifndef JSON_UNICODE
+		for(size_t i = 0; i < 40; ++i){
+			assertTrue(valid("\xC2\x80", i));  //U+0080
+			assertTrue(valid("\xC3\xA9t\xC3\xA9", i));  //été
+			assertTrue(valid("\xDF\xBF", i));  //U+07FF
+			assertTrue(valid("\xE0\xA0\x80", i));  //U+0800
+			assertTrue(valid("\xE4\xB8\xAD\xE6\x96\x87", i));  //中文
+			assertTrue(valid("\xED\x9F\xBF", i));  //U+D7FF, just before the surrogates
+			assertTrue(valid("\xEE\x80\x80", i));  //U+E000, just after them
+			assertTrue(valid("\xEF\xBF\xBF", i));  //U+FFFF
+			assertTrue(valid("\xF0\x90\x80\x80", i));  //U+10000
+			assertTrue(valid("\xF0\x9F\x98\x80", i));  //an emoji
+			assertTrue(valid("\xF4\x8F\xBF\xBF", i));  //U+10FFFF
+		}
+	#endif
+}
+
+void testJSONUtf8__isValid::testInvalid(void){
+	#ifndef JSON_UNICODE
+		for(size_t i = 0; i < 40; ++i){
+			assertFalse(valid("\x80", i));  //continuation on its own
+			assertFalse(valid("a\xBF" "b", i));
+			assertFalse(valid("\xC0\x80", i));  //overlong null
+			assertFalse(valid("\xC1\xBF", i));  //overlong
+			assertFalse(valid("\xE0\x9F\xBF", i));  //overlong
+			assertFalse(valid("\xF0\x8F\xBF\xBF", i));  //overlong
+			assertFalse(valid("\xED\xA0\x80", i));  //a surrogate
+			assertFalse(valid("\xED\xBF\xBF", i));  //a surrogate
+			assertFalse(valid("\xF4\x90\x80\x80", i));  //past U+10FFFF
+			assertFalse(valid("\xF5\x80\x80\x80", i));
+			assertFalse(valid("\xFF", i));
+			assertFalse(valid("\xC3" "a", i));  //not followed by a continuation
+			assertFalse(valid("\xE4\xB8" "a", i));
+			assertFalse(valid("\xF0\x9F\x98" "a", i));
+		}
+
+		//cut short right at the end
+		const char * const cut[] = { "\xC3", "\xE4\xB8", "\xE4", "\xF0\x9F\x98", "\xF0" };
+		for(size_t j = 0; j < sizeof(cut) / sizeof(cut[0]); ++j){
+			for(size_t i = 0; i < 20; ++i){
+				std::string text(i, 'a');
+				text += cut[j];
+				assertFalse(JSONUtf8::isValid(text.data(), text.length()));
+			}
+		}
+	#endif
+}
+
+void testJSONUtf8__isValid::testParse(void){
+	#if defined(JSON_UTF8) && defined(JSON_READ_PRIORITY)
+		//UTF-8 goes straight through both ways, \u escapes become it too
+		const json_string text(JSON_TEXT("[\"\xC3\xA9t\xC3\xA9 \xE4\xB8\xAD \xF0\x9F\x98\x80\"]"));
+		JSONNode node = libjson::parse(text);
+		assertEquals(node[0].as_string(), JSON_TEXT("\xC3\xA9t\xC3\xA9 \xE4\xB8\xAD \xF0\x9F\x98\x80"));
+		assertEquals(node.write(), text);
+		assertEquals(libjson::parse(JSON_TEXT("[\"\\u00e9\\u4E2D\\uD83D\\uDE00\"]"))[0].as_string(), JSON_TEXT("\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80"));
+
+		#if defined(JSON_SAFE) && !defined(JSON_NO_EXCEPTIONS)
+			assertException(libjson::parse(JSON_TEXT("[\"\xC3\"]")), std::invalid_argument);
+			assertException(libjson::parse(JSON_TEXT("[\"\xC0\x80\"]")), std::invalid_argument);
+			assertException(libjson::parse(JSON_TEXT("[\"\xED\xA0\x80\"]")), std::invalid_argument);
+		#endif
+
+		#ifdef JSON_VALIDATE
+			assertTrue(libjson::is_valid(text));
+			assertFalse(libjson::is_valid(JSON_TEXT("[\"\xC3\"]")));
+			assertFalse(libjson::is_valid(JSON_TEXT("[\"\xF4\x90\x80\x80\"]")));
+		#endif
+	#endif
+}
+
+/*
+ *	isValid uses lookup tables 32 bytes at a time when it can, which has to
+ *	agree with checking a byte at a time on everything, including sequences
+ *	that straddle two blocks and ones cut short by the end of the text
+ */
+void testJSONUtf8__isValid::testSameAsScan(void){
+	#ifndef JSON_UNICODE
+		static const char * const pieces[] = {
+			"a", "\"", "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\x80", "\xC0", "\xED\xA0", "\xF4", "\xFF",
+			"\xE0\x80", "\xED\x9F\xBF", "\xF4\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xE0\xA0\x80", "\xC2\x80"
+		};
+		const unsigned int count = sizeof(pieces) / sizeof(pieces[0]);
+		unsigned int seed = 12345;
+		unsigned int valid = 0;
+		for(unsigned int t = 0; t < 20000; ++t){
+			std::string text;
+			seed = seed * 1103515245 + 12345;
+			const unsigned int length = (seed >> 16) % 100;
+			for(unsigned int i = 0; i < length; ++i){
+				seed = seed * 1103515245 + 12345;
+				const unsigned int pick = (seed >> 16) % 100;
+				if (pick < 70){  //mostly ascii, with the good sequences more often than the bad ones
+					text += 'a';
+				} else if (pick < 85){
+					text += pieces[2 + (pick % 3)];
+				} else {
+					text += pieces[pick % count];
+				}
+			}
+			const bool expected = JSONUtf8::scan(text.data(), text.length());
+			if (expected) ++valid;
+			assertEquals(JSONUtf8::isValid(text.data(), text.length()), expected);
+		}
+		assertGreaterThan(valid, 100u);  //make sure that both kinds got tried
+		assertLessThan(valid, 19900u);
+	#endif
+}
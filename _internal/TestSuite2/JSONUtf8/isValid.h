@@ -0,0 +1,16 @@
+#ifndef JSON_TESTSUITE_JSON_UTF8__IS_VALID_H
+#define JSON_TESTSUITE_JSON_UTF8__IS_VALID_H
+
+#include "../BaseTest.h"
+
+class testJSONUtf8__isValid : public BaseTest {
+public:
+	testJSONUtf8__isValid(const std::string & name) : BaseTest(name){}
+	void testAscii(void);
+	void testMultiByte(void);
+	void testInvalid(void);
+	void testParse(void);
+	void testSameAsScan(void);
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "isValid_benchmark.h"
+#include "../../Source/JSONUtf8.h"
+#include <ctime>
+#include <sstream>
+
+static std::string seconds(clock_t ticks){
+	std::stringstream out;
+	out << (double)ticks / (double)CLOCKS_PER_SEC << "s";
+	return out.str();
+}
+
+/**
+ *	Checks a few megabytes of json with some text that isn't english in it,
+ *	both a byte at a time and with whatever isValid picks, and reports how long each took
+ */
+void testJSONUtf8__isValid_benchmark::testSpeed(void){
+	#ifndef JSON_UNICODE
+		std::string text("[");
+		while (text.length() < 4 * 1024 * 1024){
+			text += "{\"id\":1234567,\"name\":\"Jos\xC3\xA9 Mu\xC3\xB1oz\",\"city\":\"\xE6\x9D\xB1\xE4\xBA\xAC\",\"tags\":[\"caf\xC3\xA9\",\"\xF0\x9F\x98\x80\"],\"active\":true},";
+		}
+		text += "null]";
+
+		const unsigned int rounds = 10;
+		bool scanned = true;
+		clock_t started = clock();
+		for(unsigned int r = 0; r < rounds; ++r){
+			scanned &= JSONUtf8::scan(text.data(), text.length());
+		}
+		const clock_t scantime = clock() - started;
+
+		bool checked = true;
+		started = clock();
+		for(unsigned int r = 0; r < rounds; ++r){
+			checked &= JSONUtf8::isValid(text.data(), text.length());
+		}
+		const clock_t checktime = clock() - started;
+		assertTrue(scanned);
+		assertTrue(checked);
+
+		#ifdef JSON_SIMD
+			UnitTest::echo_(std::string("byte at a time: ") + seconds(scantime) + ", " + JSONSimd::level() + ": " + seconds(checktime));
+		#else
+			UnitTest::echo_(std::string("byte at a time: ") + seconds(scantime) + ", without simd: " + seconds(checktime));
+		#endif
+	#endif
+}
@@ -0,0 +1,12 @@
+#ifndef JSON_TESTSUITE_JSON_UTF8__IS_VALID_BENCHMARK_H
+#define JSON_TESTSUITE_JSON_UTF8__IS_VALID_BENCHMARK_H
+
+#include "../BaseTest.h"
+
+class testJSONUtf8__isValid_benchmark : public BaseTest {
+public:
+	testJSONUtf8__isValid_benchmark(const std::string & name) : BaseTest(name){}
+	void testSpeed(void);
+};
+
+#endif
@@ -37,3 +37,27 @@ void testJSONValidator__isValidRoot::testSuddenEnd(void){
 		assertFalse(JSONValidator::isValidRoot(JSON_TEXT("aoe")));
 	#endif
 }
+
+/**
+ *	Text that is only known by its length has whatever comes after it sitting
+ *	right there, the validator can't let it decide anything
+ */
+void testJSONValidator__isValidRoot::testLength(void){
+	#ifdef JSON_VALIDATE
+		const json_string text(JSON_TEXT("[\"stuff\",{\"a\":[1,2]}]\"x"));
+		assertTrue(JSONValidator::isValidRoot(text.data(), text.length() - 2));
+		assertFalse(JSONValidator::isValidRoot(text.data(), text.length() - 1));
+		assertFalse(JSONValidator::isValidRoot(text.data(), text.length()));
+		assertFalse(JSONValidator::isValidRoot(text.data(), text.length() - 3));  //ends in the middle of the object
+		assertFalse(JSONValidator::isValidRoot(text.data(), 4));  //ends in the middle of a string
+		assertFalse(JSONValidator::isValidRoot(text.data(), 0));
+
+		const json_string unterminated(JSON_TEXT("[\"stuff]\"]"));
+		assertFalse(JSONValidator::isValidRoot(unterminated.data(), 8));  //the ] is inside of the string
+		assertTrue(JSONValidator::isValidRoot(unterminated.data(), unterminated.length()));
+
+		const json_string nested(JSON_TEXT("{}{}"));
+		assertTrue(JSONValidator::isValidRoot(nested.data(), 2));
+		assertFalse(JSONValidator::isValidRoot(nested.data(), 4));
+	#endif
+}
@@ -9,6 +9,7 @@ public:
 	void testRoots(void);
 	void testNotRoots(void);
 	void testSuddenEnd(void);
+	void testLength(void);
 };
 
 #endif
@@ -0,0 +1,104 @@
+#include "FixString.h"
+#include "../../../libjson.h"
+
+/*
+ *	Strings are unescaped a block at a time, so these are repeated at many
+ *	lengths to get the escapes into every position of a block
+ */
+
+#ifdef JSON_READ_PRIORITY
+	static json_string unescaped(const json_string & text){
+		JSONNode node = libjson::parse(JSON_TEXT("[\"") + text + JSON_TEXT("\"]"));
+		return node[0].as_string();
+	}
+#endif
+
+void testJSONWorker__FixString::testPlain(void){
+	#ifdef JSON_READ_PRIORITY
+		for(size_t i = 0; i < 70; ++i){
+			const json_string text(i, JSON_TEXT('a'));
+			assertEquals(unescaped(text), text);
+
+			JSONNode node = libjson::parse(JSON_TEXT("{\"") + text + JSON_TEXT("\":\"") + text + JSON_TEXT("\"}"));
+			assertEquals(node.write(), JSON_TEXT("{\"") + text + JSON_TEXT("\":\"") + text + JSON_TEXT("\"}"));
+		}
+	#endif
+}
+
+void testJSONWorker__FixString::testEscapes(void){
+	#ifdef JSON_READ_PRIORITY
+		for(size_t i = 0; i < 70; ++i){
+			json_string text(i, JSON_TEXT('x'));
+			text += JSON_TEXT("\\n");
+			text += json_string(i, JSON_TEXT('y'));
+			text += JSON_TEXT("\\\"\\\\\\/\\t");
+			text += json_string(i % 5, JSON_TEXT('z'));
+
+			json_string expected(i, JSON_TEXT('x'));
+			expected += JSON_TEXT("\n");
+			expected += json_string(i, JSON_TEXT('y'));
+			expected += JSON_TEXT("\"\\/\t");
+			expected += json_string(i % 5, JSON_TEXT('z'));
+			assertEquals(unescaped(text), expected);
+
+			//names go through the same thing
+			JSONNode node = libjson::parse(JSON_TEXT("{\"") + text + JSON_TEXT("\":1}"));
+			assertEquals(node[0].name(), expected);
+		}
+		assertEquals(unescaped(JSON_TEXT("\\\\")), JSON_TEXT("\\"));
+		assertEquals(unescaped(JSON_TEXT("\\\\\\\\a")), JSON_TEXT("\\\\a"));
+	#endif
+}
+
+void testJSONWorker__FixString::testUnicode(void){
+	#ifdef JSON_READ_PRIORITY
+		json_string latin;
+		latin += JSON_TEXT('A');
+		#ifdef JSON_UTF8
+			latin += (json_char)0xC3;
+			latin += (json_char)0xA9;
+			latin += (json_char)0xC3;
+			latin += (json_char)0xBF;
+		#else
+			latin += (json_char)0xE9;
+			latin += (json_char)0xFF;
+		#endif
+		assertEquals(unescaped(JSON_TEXT("\\u0041\\u00e9\\u00fF")), latin);
+
+		//everything past the first 256 is UTF-8 in narrow strings
+		json_string han;
+		json_string emoji;
+		#ifdef JSON_UNICODE
+			han += (json_char)0x4E2D;
+			if (sizeof(json_char) == 2){
+				emoji += (json_char)0xD83D;
+				emoji += (json_char)0xDE00;
+			} else {
+				emoji += (json_char)0x1F600;
+			}
+		#else
+			han += (json_char)0xE4;
+			han += (json_char)0xB8;
+			han += (json_char)0xAD;
+			emoji += (json_char)0xF0;
+			emoji += (json_char)0x9F;
+			emoji += (json_char)0x98;
+			emoji += (json_char)0x80;
+		#endif
+		assertEquals(unescaped(JSON_TEXT("\\u4E2D")), han);
+		assertEquals(unescaped(JSON_TEXT("\\ud83d\\uDE00")), emoji);
+		assertEquals(unescaped(JSON_TEXT("a\\u4e2d\\uD83D\\uDE00b")), JSON_TEXT("a") + han + emoji + JSON_TEXT("b"));
+
+		for(size_t i = 0; i < 40; ++i){
+			const json_string pad(i, JSON_TEXT('-'));
+			assertEquals(unescaped(pad + JSON_TEXT("\\u4e2d") + pad), pad + han + pad);
+		}
+	#endif
+}
+
+void testJSONWorker__FixString::testHex(void){
+	#if defined(JSON_READ_PRIORITY) && !defined(JSON_STRICT) && !defined(JSON_VALIDATE)  //the validator only knows about what json allows
+		assertEquals(unescaped(JSON_TEXT("\\x41\\x6a\\x6B")), JSON_TEXT("Ajk"));
+		assertEquals(unescaped(JSON_TEXT("\\101\\x42")), JSON_TEXT("AB"));
+	#endif
+}
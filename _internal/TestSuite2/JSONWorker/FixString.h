@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__FIX_STRING_H
+#define JSON_TESTSUITE_JSON_WORKER__FIX_STRING_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__FixString : public BaseTest {
+public:
+	testJSONWorker__FixString(const std::string & name) : BaseTest(name){}
+	void testPlain(void);
+	void testEscapes(void);
+	void testUnicode(void);
+	void testHex(void);
+};
+
+#endif
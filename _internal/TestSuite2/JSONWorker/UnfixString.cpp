@@ -0,0 +1,71 @@
+#include "UnfixString.h"
+#include "../../Source/JSONWorker.h"
+
+/*
+ *	Strings are searched for what needs escaping a block at a time, so these
+ *	are repeated at many lengths to get the escapes into every position of a block
+ */
+
+static json_string escaped(const json_string & value){
+	json_string res(JSON_TEXT("\""));  //appends to whatever is already there
+	JSONWorker::UnfixString(value, true, res);
+	return res;
+}
+
+void testJSONWorker__UnfixString::testPlain(void){
+	for(size_t i = 0; i < 70; ++i){
+		const json_string text(i, JSON_TEXT('a'));
+		assertEquals(escaped(text), JSON_TEXT("\"") + text);
+
+		json_string res(JSON_TEXT("\""));
+		JSONWorker::UnfixString(text + JSON_TEXT("\"\\"), false, res);  //never got escaped in the first place
+		assertEquals(res, JSON_TEXT("\"") + text + JSON_TEXT("\"\\"));
+	}
+}
+
+void testJSONWorker__UnfixString::testEscapes(void){
+	for(size_t i = 0; i < 70; ++i){
+		json_string text(i, JSON_TEXT('a'));
+		text += JSON_TEXT("\"\\/\t\n\r\b\f");
+		text += json_string(i % 5, JSON_TEXT('b'));
+
+		json_string expected(JSON_TEXT("\""));
+		expected += json_string(i, JSON_TEXT('a'));
+		#ifdef JSON_ESCAPE_WRITES
+			expected += JSON_TEXT("\\\"\\\\\\/\\t\\n\\r\\b\\f");
+		#else
+			expected += JSON_TEXT("\\\"\\\\/\t\n\r\b\f");
+		#endif
+		expected += json_string(i % 5, JSON_TEXT('b'));
+		assertEquals(escaped(text), expected);
+	}
+	assertEquals(escaped(JSON_TEXT("\"\"")), JSON_TEXT("\"\\\"\\\""));
+}
+
+void testJSONWorker__UnfixString::testUnicode(void){
+	#ifdef JSON_ESCAPE_WRITES
+		json_string text;
+		text += (json_char)0x01;
+		text += (json_char)0x0B;
+		text += (json_char)0x7F;
+		text += (json_char)0xE9;
+		#ifdef JSON_UTF8
+			const json_string written = JSON_TEXT("\\u0001\\u000B\\u007F\xE9");  //anything past ascii is left alone
+		#else
+			const json_string written = JSON_TEXT("\\u0001\\u000B\\u007F\\u00E9");
+		#endif
+		assertEquals(escaped(text), JSON_TEXT("\"") + written);
+
+		#ifdef JSON_UNICODE
+			assertEquals(escaped(json_string(1, (json_char)0x4E2D)), JSON_TEXT("\"\\u4E2D"));
+			if (sizeof(json_char) == 4){
+				assertEquals(escaped(json_string(1, (json_char)0x1F600)), JSON_TEXT("\"\\uD83D\\uDE00"));
+			}
+		#endif
+
+		for(size_t i = 0; i < 40; ++i){
+			const json_string pad(i, JSON_TEXT('-'));
+			assertEquals(escaped(pad + text + pad), JSON_TEXT("\"") + pad + written + pad);
+		}
+	#endif
+}
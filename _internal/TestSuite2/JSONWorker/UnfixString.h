@@ -0,0 +1,14 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__UNFIX_STRING_H
+#define JSON_TESTSUITE_JSON_WORKER__UNFIX_STRING_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__UnfixString : public BaseTest {
+public:
+	testJSONWorker__UnfixString(const std::string & name) : BaseTest(name){}
+	void testPlain(void);
+	void testEscapes(void);
+	void testUnicode(void);
+};
+
+#endif
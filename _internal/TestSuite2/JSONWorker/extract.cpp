@@ -0,0 +1,100 @@
+#include "extract.h"
+#include "../../../libjson.h"
+
+#ifdef JSON_READ_PRIORITY
+	static const json_char * sample(void){
+		return JSON_TEXT("{ \"skip\" : [ {\"user\": 1}, \"}]\" ],\n")
+			   JSON_TEXT("  \"user\" : { \"name\" : \"Ann\", \"profile\" : { \"id\" : 42, \"tags\" : [ \"a\", [ 1, 2, 3 ], {\"x\":true} ] } },\n")
+			   JSON_TEXT("  \"list\" : [ 10, 20, 30 ], \"\" : \"blank\", \"nothing\" : null }");
+	}
+#endif
+
+void testJSONWorker__extract::testExtract(void){
+	#ifdef JSON_READ_PRIORITY
+		const json_string text(sample());
+		JSONNode id(libjson::extract(text, JSON_TEXT("/user/profile/id")));
+		assertEquals(id.type(), JSON_NUMBER);
+		assertEquals(id.as_int(), 42);
+		assertEquals(id.name(), JSON_TEXT("id"));
+
+		assertEquals(libjson::extract(text, JSON_TEXT("/user/name")).as_string(), JSON_TEXT("Ann"));
+		assertEquals(libjson::extract(text, JSON_TEXT("/list/2")).as_int(), 30);
+		assertEquals(libjson::extract(text, JSON_TEXT("/list/2")).name(), JSON_TEXT(""));
+		assertEquals(libjson::extract(text, JSON_TEXT("/user/profile/tags/1/2")).as_int(), 3);
+		assertTrue(libjson::extract(text, JSON_TEXT("/user/profile/tags/2/x")).as_bool());
+		assertEquals(libjson::extract(text, JSON_TEXT("/nothing")).type(), JSON_NULL);
+		assertEquals(libjson::extract(text, JSON_TEXT("/")).as_string(), JSON_TEXT("blank"));
+
+		//containers come back whole
+		JSONNode tags(libjson::extract(text, JSON_TEXT("/user/profile/tags")));
+		assertEquals(tags.type(), JSON_ARRAY);
+		assertEquals(tags.size(), 3);
+		assertEquals(tags.write(), JSON_TEXT("[\"a\",[1,2,3],{\"x\":true}]"));
+		assertEquals(tags.name(), JSON_TEXT("tags"));
+
+		JSONNode all(libjson::extract(text, JSON_TEXT("")));
+		assertEquals(all.type(), JSON_NODE);
+		assertEquals(all.size(), 5);
+		assertEquals(all[JSON_TEXT("list")][1].as_int(), 20);
+
+		//pointer and length
+		const json_string part(JSON_TEXT("[1,[2,3]]garbage"));
+		assertEquals(libjson::extract(part.data(), 9, JSON_TEXT("/1/0")).as_int(), 2);
+	#endif
+}
+
+void testJSONWorker__extract::testEscapes(void){
+	#ifdef JSON_READ_PRIORITY
+		const json_string text(JSON_TEXT("{\"a/b\":1, \"m~n\":2, \"q\\\"t\":\"x\\\"y\\n\", \"~1\":3}"));
+		assertEquals(libjson::extract(text, JSON_TEXT("/a~1b")).as_int(), 1);
+		assertEquals(libjson::extract(text, JSON_TEXT("/m~0n")).as_int(), 2);
+		assertEquals(libjson::extract(text, JSON_TEXT("/~01")).as_int(), 3);
+		JSONNode quoted(libjson::extract(text, JSON_TEXT("/q\"t")));
+		assertEquals(quoted.as_string(), JSON_TEXT("x\"y\n"));
+		assertEquals(quoted.name(), JSON_TEXT("q\"t"));
+	#endif
+}
+
+void testJSONWorker__extract::testMissing(void){
+	#if defined(JSON_READ_PRIORITY) && !defined(JSON_NO_EXCEPTIONS)
+		const json_string text(sample());
+		assertException(libjson::extract(text, JSON_TEXT("/user/profile/nope")), std::out_of_range);
+		assertException(libjson::extract(text, JSON_TEXT("/list/3")), std::out_of_range);
+		assertException(libjson::extract(text, JSON_TEXT("/list/01")), std::out_of_range);
+		assertException(libjson::extract(text, JSON_TEXT("/list/-")), std::out_of_range);
+		assertException(libjson::extract(text, JSON_TEXT("/user/name/first")), std::out_of_range);
+		assertException(libjson::extract(text, JSON_TEXT("user")), std::invalid_argument);
+		assertException(libjson::extract(text, JSON_TEXT("/a~2")), std::invalid_argument);
+		assertException(libjson::extract(JSON_TEXT("{\"a\":[1,2"), JSON_TEXT("/b")), std::invalid_argument);
+	#endif
+}
+
+void testJSONWorker__extract::testAtPointer(void){
+	#ifdef JSON_READ_PRIORITY
+		const json_string text(sample());
+		JSONNode doc(libjson::parse(text));
+		assertEquals(doc.at_pointer(JSON_TEXT("/user/profile/id")).as_int(), 42);
+		assertEquals(doc.at_pointer(JSON_TEXT("/user/profile/tags/1/0")).as_int(), 1);
+		assertEquals(doc.at_pointer(JSON_TEXT("/list/1")).as_int(), 20);
+		assertEquals(doc.at_pointer(JSON_TEXT("")).size(), 5);
+
+		//some of the tree fetched, the rest still text
+		assertEquals(doc[JSON_TEXT("user")][JSON_TEXT("name")].as_string(), JSON_TEXT("Ann"));
+		assertEquals(doc.at_pointer(JSON_TEXT("/user/profile/tags/2/x")).as_bool(), true);
+		assertEquals(doc.at_pointer(JSON_TEXT("/user/name")).as_string(), JSON_TEXT("Ann"));
+
+		//a tree that was built by hand
+		JSONNode built(JSON_NODE);
+		JSONNode arr(JSON_ARRAY);
+		arr.set_name(JSON_TEXT("a/b"));
+		arr.push_back(JSONNode(JSON_TEXT(""), 5));
+		built.push_back(arr);
+		assertEquals(built.at_pointer(JSON_TEXT("/a~1b/0")).as_int(), 5);
+
+		#ifndef JSON_NO_EXCEPTIONS
+			assertException(doc.at_pointer(JSON_TEXT("/user/missing")), std::out_of_range);
+			assertException(built.at_pointer(JSON_TEXT("/a~1b/1")), std::out_of_range);
+			assertException(built.at_pointer(JSON_TEXT("/a~1b/0/x")), std::out_of_range);
+		#endif
+	#endif
+}
@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__EXTRACT_H
+#define JSON_TESTSUITE_JSON_WORKER__EXTRACT_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__extract : public BaseTest {
+public:
+	testJSONWorker__extract(const std::string & name) : BaseTest(name){}
+	void testExtract(void);
+	void testEscapes(void);
+	void testMissing(void);
+	void testAtPointer(void);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "parse.h"
+#include "../../../libjson.h"
+
+#include <vector>
+
+/*
+ *	The text is sliced out of the middle of a bigger buffer, with no null
+ *	terminator after it, the way that it comes out of a network read
+ */
+
+#ifdef JSON_READ_PRIORITY
+	static void slice(const json_string & before, const json_string & json, const json_string & after, std::vector<json_char> & buffer){
+		buffer.assign(before.begin(), before.end());
+		buffer.insert(buffer.end(), json.begin(), json.end());
+		buffer.insert(buffer.end(), after.begin(), after.end());
+	}
+#endif
+
+void testJSONWorker__parse::testPointerAndLength(void){
+	#ifdef JSON_READ_PRIORITY
+		const json_string json(JSON_TEXT("{ \"a\" : [ 1, \"two\" ],\n\t\"b\" : { \"c\" : null } }"));
+		std::vector<json_char> buffer;
+		slice(JSON_TEXT("]]\""), json, JSON_TEXT("\"{["), buffer);
+		JSONNode node = libjson::parse(&buffer[3], json.length());
+		assertEquals(node.write(), libjson::parse(json).write());
+		assertEquals(node[JSON_TEXT("a")][1].as_string(), JSON_TEXT("two"));
+		assertEquals(node[JSON_TEXT("b")][JSON_TEXT("c")].type(), JSON_NULL);
+
+		//stripping stops at the end, even in the middle of a string or a comment
+		assertEquals(libjson::strip_white_space(&buffer[3], 15), JSON_TEXT("{\"a\":[1,\"t"));
+		#if !defined(JSON_COMMENTS) && !defined(JSON_STRICT)  //otherwise the comment is kept
+			const json_string comment(JSON_TEXT("[ 1 ] /* trailing */"));
+			assertEquals(libjson::strip_white_space(comment.data(), comment.length() - 2), JSON_TEXT("[1]"));
+			assertEquals(libjson::strip_white_space(comment.data(), comment.length() - 14), JSON_TEXT("[1]"));
+		#endif
+	#endif
+}
+
+void testJSONWorker__parse::testUnformatted(void){
+	#ifdef JSON_READ_PRIORITY
+		const json_string json(JSON_TEXT("[1,{\"x\":\"y\"},[true]]"));
+		std::vector<json_char> buffer;
+		slice(JSON_TEXT("{["), json, JSON_TEXT("]]"), buffer);
+		JSONNode node = libjson::parse_unformatted(&buffer[2], json.length());
+		assertEquals(node.size(), 3);
+		assertEquals(node[1][JSON_TEXT("x")].as_string(), JSON_TEXT("y"));
+		assertEquals(node.write(), json);
+		#ifdef JSON_VALIDATE
+			assertTrue(libjson::is_valid(&buffer[2], json.length()));
+			assertTrue(libjson::is_valid_unformatted(&buffer[2], json.length()));
+			assertFalse(libjson::is_valid_unformatted(&buffer[2], json.length() - 1));
+			assertFalse(libjson::is_valid_unformatted(&buffer[0], json.length() + 4));
+		#endif
+	#endif
+}
+
+void testJSONWorker__parse::testStringView(void){
+	#if defined(JSON_READ_PRIORITY) && defined(JSON_STRING_VIEW)
+		const json_string json(JSON_TEXT("{\"a\":[1,2,3]}trailing"));
+		const json_string_view view(json.data(), json.length() - 8);
+		assertEquals(libjson::parse(view)[JSON_TEXT("a")].size(), 3);
+		assertEquals(libjson::parse_unformatted(view).write(), JSON_TEXT("{\"a\":[1,2,3]}"));
+		assertEquals(libjson::parse(JSON_TEXT("[ 1 ]")).size(), 1);
+		#ifdef JSON_VALIDATE
+			assertTrue(libjson::is_valid(view));
+			assertTrue(libjson::is_valid_unformatted(view));
+			assertFalse(libjson::is_valid_unformatted(JSON_TEXT("[ 1 ]")));
+		#endif
+	#endif
+}
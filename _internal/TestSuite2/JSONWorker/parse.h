@@ -0,0 +1,14 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__PARSE_H
+#define JSON_TESTSUITE_JSON_WORKER__PARSE_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__parse : public BaseTest {
+public:
+	testJSONWorker__parse(const std::string & name) : BaseTest(name){}
+	void testPointerAndLength(void);
+	void testUnformatted(void);
+	void testStringView(void);
+};
+
+#endif
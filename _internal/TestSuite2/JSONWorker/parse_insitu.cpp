@@ -0,0 +1,107 @@
+#include "parse_insitu.h"
+#include "../../../libjson.h"
+
+#include <vector>
+
+/*
+ *	The buffer is stripped in place, so the white space is grown a little
+ *	bit at a time to make sure that the output lands at every distance
+ *	behind the input, including the ones inside of a single SIMD block
+ */
+
+#ifdef JSON_READ_PRIORITY
+	static JSONNode parseCopy(const json_string & json, std::vector<json_char> & buffer){
+		buffer.assign(json.begin(), json.end());
+		buffer.push_back(JSON_TEXT('\0'));
+		return libjson::parse_insitu(&buffer[0], json.length());
+	}
+#endif
+
+void testJSONWorker__parse_insitu::testSameAsParse(void){
+	#ifdef JSON_READ_PRIORITY
+		for(size_t i = 0; i < 70; ++i){
+			json_string json = JSON_TEXT("{\n");
+			json += json_string(i, JSON_TEXT(' '));
+			json += JSON_TEXT("\"key\"\t:\r\n");
+			json += json_string(i % 7, JSON_TEXT('\t'));
+			json += JSON_TEXT("[");
+			json += json_string(i % 10 + 1, JSON_TEXT('1'));
+			json += JSON_TEXT(" , true,\tnull , { \"inner\" : \"");
+			json += json_string(i, JSON_TEXT('x'));
+			json += JSON_TEXT("\" } ]");
+			json += json_string(i, JSON_TEXT('\n'));
+			json += JSON_TEXT(",\"last\" : -1.5 }");
+
+			std::vector<json_char> buffer;
+			JSONNode node = parseCopy(json, buffer);
+			assertEquals(node.write(), libjson::parse(json).write());
+			assertEquals(node[JSON_TEXT("key")][3][JSON_TEXT("inner")].as_string(), json_string(i, JSON_TEXT('x')));
+			assertEquals(node[JSON_TEXT("last")].as_float(), -1.5);
+		}
+	#endif
+}
+
+void testJSONWorker__parse_insitu::testStrings(void){
+	#ifdef JSON_READ_PRIORITY
+		for(size_t i = 0; i < 70; ++i){
+			//escaped quotes get swapped for \1 in the buffer, they still have to come out right
+			json_string json = JSON_TEXT("[ \"");
+			json += json_string(i, JSON_TEXT(' '));
+			json += JSON_TEXT("a\\\"b\\\\\\n");
+			json += json_string(i, JSON_TEXT('x'));
+			json += JSON_TEXT("\" ,\t\"/#,]\" ]");
+
+			json_string expected = json_string(i, JSON_TEXT(' '));
+			expected += JSON_TEXT("a\"b\\\n");
+			expected += json_string(i, JSON_TEXT('x'));
+
+			std::vector<json_char> buffer;
+			JSONNode node = parseCopy(json, buffer);
+			assertEquals(node.size(), 2);
+			assertEquals(node[0].as_string(), expected);
+			assertEquals(node[1].as_string(), JSON_TEXT("/#,]"));
+			assertEquals(node.write(), libjson::parse(json).write());
+		}
+	#endif
+}
+
+void testJSONWorker__parse_insitu::testComments(void){
+	#if defined(JSON_READ_PRIORITY) && !defined(JSON_STRICT)
+		for(size_t i = 0; i < 40; ++i){
+			json_string json = JSON_TEXT("#root\n{");
+			json += json_string(i, JSON_TEXT(' '));
+			json += JSON_TEXT("# about a\n \"a\" : 1,\n//about b\n\"b\" : [ 2 ]\n}");
+
+			std::vector<json_char> buffer;
+			JSONNode node = parseCopy(json, buffer);
+			assertEquals(node.size(), 2);
+			assertEquals(node[JSON_TEXT("a")].as_int(), 1);
+			assertEquals(node[JSON_TEXT("b")][0].as_int(), 2);
+			#ifdef JSON_COMMENTS
+				assertEquals(node.get_comment(), JSON_TEXT("root"));
+				assertEquals(node[JSON_TEXT("a")].get_comment(), JSON_TEXT(" about a"));
+				assertEquals(node[JSON_TEXT("b")].get_comment(), JSON_TEXT("about b"));
+			#endif
+		}
+	#endif
+}
+
+/**
+ *	Nodes that came out of the buffer have to stay good for as long as the
+ *	buffer is, even after the root that they were parsed with is gone
+ */
+void testJSONWorker__parse_insitu::testCopies(void){
+	#ifdef JSON_READ_PRIORITY
+		std::vector<json_char> buffer;
+		JSONNode copy;
+		{
+			JSONNode node = parseCopy(JSON_TEXT("{ \"a\" : { \"b\" : [ 1, 2, 3 ] }, \"c\" : \"d\" }"), buffer);
+			copy = node[JSON_TEXT("a")];
+			JSONNode duplicate = node.duplicate();
+			assertEquals(duplicate.write(), JSON_TEXT("{\"a\":{\"b\":[1,2,3]},\"c\":\"d\"}"));
+		}
+		assertEquals(copy.write(), JSON_TEXT("{\"b\":[1,2,3]}"));
+		assertEquals(copy[JSON_TEXT("b")].size(), 3);
+		assertEquals(copy[JSON_TEXT("b")][2].as_int(), 3);
+	#endif
+}
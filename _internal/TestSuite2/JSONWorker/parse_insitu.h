@@ -0,0 +1,15 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__PARSE_INSITU_H
+#define JSON_TESTSUITE_JSON_WORKER__PARSE_INSITU_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__parse_insitu : public BaseTest {
+public:
+	testJSONWorker__parse_insitu(const std::string & name) : BaseTest(name){}
+	void testSameAsParse(void);
+	void testStrings(void);
+	void testComments(void);
+	void testCopies(void);
+};
+
+#endif
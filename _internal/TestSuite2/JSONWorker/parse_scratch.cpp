@@ -0,0 +1,50 @@
+#include "parse_scratch.h"
+#include "../../Source/JSONWorker.h"
+
+#include <algorithm>
+#include <vector>
+
+/*
+ *	The buffer is stripped where it is like parse_insitu, but the nodes
+ *	mustn't point into it, since streams reuse it for the next object
+ */
+
+#ifdef JSON_READ_PRIORITY
+	static JSONNode parseCopy(const json_string & json, std::vector<json_char> & buffer){
+		buffer.assign(json.begin(), json.end());
+		return JSONWorker::parse_scratch(&buffer[0], json.length());
+	}
+#endif
+
+void testJSONWorker__parse_scratch::testSameAsParse(void){
+	#ifdef JSON_READ_PRIORITY
+		for(size_t i = 0; i < 70; ++i){
+			json_string json = JSON_TEXT("{\n");
+			json += json_string(i, JSON_TEXT(' '));
+			json += JSON_TEXT("\"key\"\t:\r\n[");
+			json += json_string(i % 10 + 1, JSON_TEXT('1'));
+			json += JSON_TEXT(" , true,\tnull , { \"inner\" : \"a\\\"");
+			json += json_string(i, JSON_TEXT('x'));
+			json += JSON_TEXT("\" } ]");
+			json += json_string(i, JSON_TEXT('\n'));
+			json += JSON_TEXT(",\"last\" : -1.5 }");
+
+			std::vector<json_char> buffer;
+			JSONNode node = parseCopy(json, buffer);
+			assertEquals(node.write(), JSONWorker::parse(json).write());
+			assertEquals(node[JSON_TEXT("key")][3][JSON_TEXT("inner")].as_string(), JSON_TEXT("a\"") + json_string(i, JSON_TEXT('x')));
+			assertEquals(node[JSON_TEXT("last")].as_float(), -1.5);
+		}
+	#endif
+}
+
+void testJSONWorker__parse_scratch::testReused(void){
+	#ifdef JSON_READ_PRIORITY
+		std::vector<json_char> buffer;
+		JSONNode node = parseCopy(JSON_TEXT("{ \"a\" : { \"b\" : [ 1, \"two\", 3 ] }, \"c\" : \"d\" }"), buffer);
+		std::fill(buffer.begin(), buffer.end(), JSON_TEXT('#'));
+		assertEquals(node.write(), JSON_TEXT("{\"a\":{\"b\":[1,\"two\",3]},\"c\":\"d\"}"));
+		assertEquals(node[JSON_TEXT("a")][JSON_TEXT("b")][1].as_string(), JSON_TEXT("two"));
+		assertEquals(node[JSON_TEXT("c")].as_string(), JSON_TEXT("d"));
+	#endif
+}
@@ -0,0 +1,13 @@
+#ifndef JSON_TESTSUITE_JSON_WORKER__PARSE_SCRATCH_H
+#define JSON_TESTSUITE_JSON_WORKER__PARSE_SCRATCH_H
+
+#include "../BaseTest.h"
+
+class testJSONWorker__parse_scratch : public BaseTest {
+public:
+	testJSONWorker__parse_scratch(const std::string & name) : BaseTest(name){}
+	void testSameAsParse(void);
+	void testReused(void);
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "_atof_benchmark.h"
+#include "../../Source/NumberToString.h"
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <sstream>
+
+//how numbers used to be read, a digit at a time and then scaled by a power of ten
+static json_number naive(const json_char * num, size_t len){
+	const json_char * const end = num + len;
+	json_number sign = (json_number)1.0;
+	if (*num == JSON_TEXT('-')){
+		sign = -1.0;
+		++num;
+	}
+	json_number n = (json_number)0.0;
+	int scale = 0;
+	for(; num != end && *num >= JSON_TEXT('0') && *num <= JSON_TEXT('9'); ++num){
+		n = (n * 10.0) + (*num - JSON_TEXT('0'));
+	}
+	if (num != end && *num == JSON_TEXT('.')){
+		for(++num; num != end && *num >= JSON_TEXT('0') && *num <= JSON_TEXT('9'); ++num){
+			n = (n * 10.0) + (*num - JSON_TEXT('0'));
+			--scale;
+		}
+	}
+	int subscale = 0, signsubscale = 1;
+	if (num != end && (*num == JSON_TEXT('e') || *num == JSON_TEXT('E'))){
+		++num;
+		if (*num == JSON_TEXT('-')){
+			signsubscale = -1;
+			++num;
+		} else if (*num == JSON_TEXT('+')){
+			++num;
+		}
+		for(; num != end && *num >= JSON_TEXT('0') && *num <= JSON_TEXT('9'); ++num){
+			subscale = (subscale * 10) + (*num - JSON_TEXT('0'));
+		}
+	}
+	return sign * n * std::pow((json_number)10.0, scale + subscale * signsubscale);
+}
+
+//how the non strict build used to read them, narrowed and handed to the c library
+static json_number library(const json_char * num, size_t len){
+	char temp[64];
+	for(size_t i = 0; i < len; ++i){
+		temp[i] = (char)num[i];
+	}
+	temp[len] = '\0';
+	return (json_number)std::atof(temp);
+}
+
+static std::string seconds(clock_t ticks){
+	std::stringstream out;
+	out << (double)ticks / (double)CLOCKS_PER_SEC << "s";
+	return out.str();
+}
+
+/**
+ *	Reads a telemetry sized batch of numbers each way, and reports how long each one took
+ */
+void testNumberToString__atof_benchmark::testSpeed(void){
+	static const json_char * const numbers[] = {
+		JSON_TEXT("0"), JSON_TEXT("1"), JSON_TEXT("-42"), JSON_TEXT("1337"),
+		JSON_TEXT("3.14159"), JSON_TEXT("-0.000123"), JSON_TEXT("98.6"), JSON_TEXT("1234567.891"),
+		JSON_TEXT("6.02214076e23"), JSON_TEXT("-1.602176634e-19"), JSON_TEXT("0.1"), JSON_TEXT("2.718281828459045"),
+		JSON_TEXT("-8.5e-7"), JSON_TEXT("47.6062095"), JSON_TEXT("-122.3320708"), JSON_TEXT("1606780800123")
+	};
+	const size_t count = sizeof(numbers) / sizeof(numbers[0]);
+	size_t lengths[sizeof(numbers) / sizeof(numbers[0])];
+	for(size_t i = 0; i < count; ++i){
+		lengths[i] = json_strlen(numbers[i]);
+	}
+
+	//they have to agree on everything before the times mean anything
+	for(size_t i = 0; i < count; ++i){
+		assertTrue(_floatsAreEqual(NumberToString::_atof(numbers[i], lengths[i]), library(numbers[i], lengths[i])));
+	}
+
+	const unsigned int rounds = 20000;
+	volatile json_number sink = 0;
+	clock_t started = clock();
+	for(unsigned int r = 0; r < rounds; ++r){
+		for(size_t i = 0; i < count; ++i){
+			sink = sink + naive(numbers[i], lengths[i]);
+		}
+	}
+	const clock_t naivetime = clock() - started;
+
+	started = clock();
+	for(unsigned int r = 0; r < rounds; ++r){
+		for(size_t i = 0; i < count; ++i){
+			sink = sink + library(numbers[i], lengths[i]);
+		}
+	}
+	const clock_t librarytime = clock() - started;
+
+	started = clock();
+	for(unsigned int r = 0; r < rounds; ++r){
+		for(size_t i = 0; i < count; ++i){
+			sink = sink + NumberToString::_atof(numbers[i], lengths[i]);
+		}
+	}
+	const clock_t fasttime = clock() - started;
+
+	UnitTest::echo_("pow scaling: " + seconds(naivetime) + ", atof: " + seconds(librarytime) + ", _atof: " + seconds(fasttime));
+}
@@ -0,0 +1,12 @@
+#ifndef JSON_TESTSUITE_NUMBER_TO_STRING__ATOF_BENCHMARK_H
+#define JSON_TESTSUITE_NUMBER_TO_STRING__ATOF_BENCHMARK_H
+
+#include "../BaseTest.h"
+
+class testNumberToString__atof_benchmark : public BaseTest {
+public:
+	testNumberToString__atof_benchmark(const std::string & name) : BaseTest(name){}
+	void testSpeed(void);
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "_atoi.h"
+#include "../../Source/NumberToString.h"
+
+static bool whole(const json_string & text, unsigned long long & magnitude, bool & negative){
+	return NumberToString::_atoi(text.data(), text.length(), magnitude, negative);
+}
+
+/**
+ *	Test that plain integers are read exactly
+ */
+void testNumberToString__atoi::testWhole(void){
+	unsigned long long magnitude;
+	bool negative;
+	assertTrue(whole(JSON_TEXT("0"), magnitude, negative));
+	assertTrue(magnitude == 0);
+	assertFalse(negative);
+	assertTrue(whole(JSON_TEXT("12"), magnitude, negative));
+	assertTrue(magnitude == 12);
+	assertFalse(negative);
+	assertTrue(whole(JSON_TEXT("-12"), magnitude, negative));
+	assertTrue(magnitude == 12);
+	assertTrue(negative);
+	assertTrue(whole(JSON_TEXT("9007199254740993"), magnitude, negative));  //not a double
+	assertTrue(magnitude == 9007199254740993ULL);
+
+	//the text doesn't have to be terminated
+	const json_string text(JSON_TEXT("12345,"));
+	assertTrue(NumberToString::_atoi(text.data(), 3, magnitude, negative));
+	assertTrue(magnitude == 123);
+
+	#ifdef JSON_STRICT
+		assertFalse(whole(JSON_TEXT("+12"), magnitude, negative));
+	#else
+		assertTrue(whole(JSON_TEXT("+12"), magnitude, negative));
+		assertTrue(magnitude == 12);
+		assertFalse(negative);
+	#endif
+}
+
+/**
+ *	Test the ends of 64 bits
+ */
+void testNumberToString__atoi::testLimits(void){
+	unsigned long long magnitude;
+	bool negative;
+	assertTrue(whole(JSON_TEXT("18446744073709551615"), magnitude, negative));
+	assertTrue(magnitude == 18446744073709551615ULL);
+	assertFalse(whole(JSON_TEXT("18446744073709551616"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("100000000000000000000"), magnitude, negative));
+
+	assertTrue(whole(JSON_TEXT("-9223372036854775808"), magnitude, negative));
+	assertTrue(magnitude == 9223372036854775808ULL);
+	assertTrue(negative);
+	assertFalse(whole(JSON_TEXT("-9223372036854775809"), magnitude, negative));
+}
+
+/**
+ *	Test that anything with a fraction, exponent or odd form is left for _atof
+ */
+void testNumberToString__atoi::testNotWhole(void){
+	unsigned long long magnitude;
+	bool negative;
+	assertFalse(whole(JSON_TEXT("1.5"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("1.0"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("1e3"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("1E3"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("0.5"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("0x1F"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("017"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("-0"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("-"), magnitude, negative));
+	assertFalse(whole(JSON_TEXT(""), magnitude, negative));
+	assertFalse(whole(JSON_TEXT("12a"), magnitude, negative));
+}
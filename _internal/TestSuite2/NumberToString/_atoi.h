@@ -0,0 +1,14 @@
+#ifndef JSON_TESTSUITE_NUMBER_TO_STRING__ATOI_H
+#define JSON_TESTSUITE_NUMBER_TO_STRING__ATOI_H
+
+#include "../BaseTest.h"
+
+class testNumberToString__atoi : public BaseTest {
+public:
+	testNumberToString__atoi(const std::string & name) : BaseTest(name){}
+	void testWhole(void);
+	void testLimits(void);
+	void testNotWhole(void);
+};
+
+#endif
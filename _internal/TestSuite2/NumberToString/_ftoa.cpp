@@ -1,5 +1,6 @@
 #include "_ftoa.h"
 #include "../../Source/NumberToString.h"
+#include <cstring>
 
 
 /**
@@ -30,9 +31,63 @@ void testNumberToString__ftoa::testSpecializedInts(void){
     assertEquals(NumberToString::_ftoa((json_number)  0.0),    JSON_TEXT(  "0"));
 	assertEquals(NumberToString::_ftoa((json_number) -0.0),    JSON_TEXT(  "0"));
 	
-	//close enough to an int
-	assertEquals(NumberToString::_ftoa((json_number)  1.000000001),  JSON_TEXT( "1"));
-	assertEquals(NumberToString::_ftoa((json_number) -1.000000001), JSON_TEXT( "-1"));
-	assertEquals(NumberToString::_ftoa((json_number)  0.000000001),  JSON_TEXT( "0"));
-	assertEquals(NumberToString::_ftoa((json_number) -0.000000001),  JSON_TEXT( "0"));
+	//close to an int, but not one
+	#if !defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+		assertEquals(NumberToString::_ftoa((json_number)  1.000000001),  JSON_TEXT( "1.000000001"));
+		assertEquals(NumberToString::_ftoa((json_number) -1.000000001), JSON_TEXT( "-1.000000001"));
+	#endif
+	assertEquals(NumberToString::_ftoa((json_number)  0.000000001),  JSON_TEXT( "1e-9"));
+	assertEquals(NumberToString::_ftoa((json_number) -0.000000001),  JSON_TEXT( "-1e-9"));
+}
+
+/**
+ *	Very big and very small numbers go to scientific notation instead of a long run of zeros
+ */
+void testNumberToString__ftoa::testExponents(void){
+	assertEquals(NumberToString::_ftoa((json_number)0.5),    JSON_TEXT("0.5"));
+	assertEquals(NumberToString::_ftoa((json_number)0.001),  JSON_TEXT("0.001"));
+	assertEquals(NumberToString::_ftoa((json_number)0.000001),  JSON_TEXT("0.000001"));
+	assertEquals(NumberToString::_ftoa((json_number)0.0000001),  JSON_TEXT("1e-7"));
+	assertEquals(NumberToString::_ftoa((json_number)-2.5e-8),  JSON_TEXT("-2.5e-8"));
+	assertEquals(NumberToString::_ftoa((json_number)1e21),  JSON_TEXT("1e21"));
+	assertEquals(NumberToString::_ftoa((json_number)1.5e30),  JSON_TEXT("1.5e30"));
+	#if !defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+		assertEquals(NumberToString::_ftoa(0.1),  JSON_TEXT("0.1"));
+		assertEquals(NumberToString::_ftoa(1.0 / 3.0),  JSON_TEXT("0.3333333333333333"));
+		assertEquals(NumberToString::_ftoa(123456.789),  JSON_TEXT("123456.789"));
+		assertEquals(NumberToString::_ftoa(1e20),  JSON_TEXT("100000000000000000000"));
+		assertEquals(NumberToString::_ftoa(1.7976931348623157e308),  JSON_TEXT("1.7976931348623157e308"));
+		assertEquals(NumberToString::_ftoa(-2.2250738585072014e-308),  JSON_TEXT("-2.2250738585072014e-308"));
+	#elif defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+		assertEquals(NumberToString::_ftoa(0.1f),  JSON_TEXT("0.1"));
+		assertEquals(NumberToString::_ftoa(3.4028235e38f),  JSON_TEXT("3.4028235e38"));
+	#endif
+
+	//and it appends onto whatever is already there
+	json_string res(JSON_TEXT("x="));
+	NumberToString::_ftoa((json_number)0.25, res);
+	assertEquals(res, JSON_TEXT("x=0.25"));
+}
+
+/**
+ *	Whatever is written has to read back as exactly the same number
+ */
+void testNumberToString__ftoa::testRoundTrip(void){
+	#if !defined(JSON_LESS_MEMORY) && !defined(JSON_NUMBER_TYPE)
+		unsigned long long state = 0x9E3779B97F4A7C15ULL;
+		size_t wrong = 0;
+		for(unsigned int i = 0; i < 20000; ++i){
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			double value;
+			const unsigned long long bits = state & 0xFFEFFFFFFFFFFFFFULL;  //no infinities or nans
+			std::memcpy(&value, &bits, sizeof(value));
+			const json_string text(NumberToString::_ftoa(value));
+			const double back = NumberToString::_atof(text.data(), text.length());
+			if (std::memcmp(&value, &back, sizeof(value)) != 0 && value != 0) ++wrong;
+			if (text.length() > 25) ++wrong;  //-0.00000 and 17 digits is as long as it gets
+		}
+		assertEquals(wrong, 0);
+	#endif
 }
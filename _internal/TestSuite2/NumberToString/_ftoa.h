@@ -8,6 +8,8 @@ public:
 	testNumberToString__ftoa(const std::string & name) : BaseTest(name){}
 	void testRandomNumbers(void);
 	void testSpecializedInts(void);
+	void testExponents(void);
+	void testRoundTrip(void);
 };
 
 #endif
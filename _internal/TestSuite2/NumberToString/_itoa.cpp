@@ -1,5 +1,6 @@
 #include "_itoa.h"
 #include "../../Source/NumberToString.h"
+#include <limits>
 
 
 /**
@@ -104,3 +105,44 @@ void testNumberToString__itoa::testLongLong(void){
 	assertEquals(NumberToString::_itoa<long long>((long long)-2147483647), JSON_TEXT("-2147483647"));
 	//AssertScopeCoverage(_itoa);
 }
+
+
+/**
+ *	Test the most negative and positive 64 bit values, which used to go through long
+ */
+void testNumberToString__itoa::testExtremes(void){
+	assertEquals(NumberToString::_itoa<long long>(std::numeric_limits<long long>::max()), JSON_TEXT("9223372036854775807"));
+	assertEquals(NumberToString::_itoa<long long>(std::numeric_limits<long long>::min()), JSON_TEXT("-9223372036854775808"));
+	assertEquals(NumberToString::_itoa<int>(std::numeric_limits<int>::min()), JSON_TEXT("-2147483648"));
+	assertEquals(NumberToString::_itoa<short>(std::numeric_limits<short>::min()), JSON_TEXT("-32768"));
+	assertEquals(NumberToString::_itoa<char>((char)-128), JSON_TEXT("-128"));
+
+	//every digit count, and both sides of each power of ten
+	long long power = 1;
+	for(int digits = 1; digits < 19; ++digits){
+		json_string expected(JSON_TEXT("1"));
+		expected.append(digits - 1, JSON_TEXT('0'));
+		assertEquals(NumberToString::_itoa<long long>(power), expected);
+		assertEquals(NumberToString::_itoa<long long>(-power), JSON_TEXT("-") + expected);
+		assertEquals(NumberToString::_itoa<long long>(power - 1).length(), (digits == 1) ? 1 : digits - 1);
+		power *= 10;
+	}
+}
+
+/**
+ *	Test appending onto a string and writing into a buffer
+ */
+void testNumberToString__itoa::testAppend(void){
+	json_string out(JSON_TEXT("["));
+	NumberToString::_itoa<int>(-42, out);
+	out += JSON_TEXT(",");
+	NumberToString::_itoa<long long>(1606780800123LL, out);
+	out += JSON_TEXT(",");
+	NumberToString::_itoa<short>((short)0, out);
+	assertEquals(out, JSON_TEXT("[-42,1606780800123,0"));
+
+	json_char buffer[getLenSize<sizeof(long)>::GETLEN];
+	json_char * end = NumberToString::_itoa<long>(-1234567L, buffer);
+	assertEquals(end - buffer, 8);
+	assertEquals(json_string(buffer, end), JSON_TEXT("-1234567"));
+}
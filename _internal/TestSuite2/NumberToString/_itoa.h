@@ -11,6 +11,8 @@ public:
 	void testInt(void);
 	void testLong(void);
 	void testLongLong(void);
+	void testExtremes(void);
+	void testAppend(void);
 };
 
 #endif
@@ -0,0 +1,70 @@
+#include "_itoa_benchmark.h"
+#include "../../Source/NumberToString.h"
+#include <ctime>
+#include <sstream>
+
+//how integers used to be written, a digit at a time into a string of their own
+static json_string naive(long long val){
+	json_char buffer[getLenSize<sizeof(long long)>::GETLEN];
+	buffer[getLenSize<sizeof(long long)>::GETLEN - 1] = JSON_TEXT('\0');
+	json_char * runner = &buffer[getLenSize<sizeof(long long)>::GETLEN - 2];
+	long long value = val;
+	const bool negative = value < 0;
+	if (negative) value = -value;
+	do {
+		*runner-- = (json_char)(value % 10) + JSON_TEXT('0');
+	} while(value /= 10);
+	if (negative){
+		*runner = JSON_TEXT('-');
+		return json_string(runner);
+	}
+	return json_string(runner + 1);
+}
+
+static std::string seconds(clock_t ticks){
+	std::stringstream out;
+	out << (double)ticks / (double)CLOCKS_PER_SEC << "s";
+	return out.str();
+}
+
+/**
+ *	Writes an array of ids and timestamps each way, and reports how long each one took
+ */
+void testNumberToString__itoa_benchmark::testSpeed(void){
+	static const long long numbers[] = {
+		0, 1, -42, 1337, 65535, -2147483647LL, 1606780800123LL, 42, 7, 100, 123456789LL, -1,
+		9007199254740993LL, 31, 2024, 86400000LL
+	};
+	const size_t count = sizeof(numbers) / sizeof(numbers[0]);
+
+	//they have to agree on everything before the times mean anything
+	for(size_t i = 0; i < count; ++i){
+		assertEquals(NumberToString::_itoa<long long>(numbers[i]), naive(numbers[i]));
+	}
+
+	const unsigned int rounds = 20000;
+	json_string array;
+	clock_t started = clock();
+	for(unsigned int r = 0; r < rounds; ++r){
+		array.clear();
+		for(size_t i = 0; i < count; ++i){
+			array += naive(numbers[i]);
+			array += JSON_TEXT(',');
+		}
+	}
+	const clock_t naivetime = clock() - started;
+	const json_string expected(array);
+
+	started = clock();
+	for(unsigned int r = 0; r < rounds; ++r){
+		array.clear();
+		for(size_t i = 0; i < count; ++i){
+			NumberToString::_itoa<long long>(numbers[i], array);
+			array += JSON_TEXT(',');
+		}
+	}
+	const clock_t fasttime = clock() - started;
+	assertEquals(array, expected);
+
+	UnitTest::echo_("digit at a time: " + seconds(naivetime) + ", digit pairs: " + seconds(fasttime));
+}
@@ -0,0 +1,12 @@
+#ifndef JSON_TESTSUITE_NUMBER_TO_STRING__ITOA_BENCHMARK_H
+#define JSON_TESTSUITE_NUMBER_TO_STRING__ITOA_BENCHMARK_H
+
+#include "../BaseTest.h"
+
+class testNumberToString__itoa_benchmark : public BaseTest {
+public:
+	testNumberToString__itoa_benchmark(const std::string & name) : BaseTest(name){}
+	void testSpeed(void);
+};
+
+#endif
@@ -76,3 +76,18 @@ void testNumberToString__uitoa::testLongLong(void){
 	assertEquals(NumberToString::_uitoa<unsigned long long>((unsigned long long)15), JSON_TEXT("15"));
 	assertEquals(NumberToString::_uitoa<unsigned long long>((unsigned long long)0), JSON_TEXT("0"));
 }
+
+
+/**
+ *	Test appending onto a string, all the way up to the largest 64 bit value
+ */
+void testNumberToString__uitoa::testAppend(void){
+	json_string out;
+	NumberToString::_uitoa<unsigned long long>(18446744073709551615ULL, out);
+	assertEquals(out, JSON_TEXT("18446744073709551615"));
+	out += JSON_TEXT(" ");
+	NumberToString::_uitoa<unsigned char>((unsigned char)255, out);
+	assertEquals(out, JSON_TEXT("18446744073709551615 255"));
+	assertEquals(NumberToString::_uitoa<unsigned long long>(10000000000000000000ULL), JSON_TEXT("10000000000000000000"));
+	assertEquals(NumberToString::_uitoa<unsigned long long>(9999999999999999999ULL), JSON_TEXT("9999999999999999999"));
+}
@@ -11,6 +11,7 @@ public:
 	void testInt(void);
 	void testLong(void);
 	void testLongLong(void);
+	void testAppend(void);
 };
 
 #endif
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "_internal/Source/JSONDefs.h"
+#include "_internal/Source/JSONDocument.h"
 #include "_internal/Source/JSONNode.h"
 #include "_internal/Source/JSONPreparse.h"
+#include "_internal/Source/JSONSax.h"
+#include "_internal/Source/JSONReader.h"
 #include "_internal/Source/JSONStream.h"
 #include "_internal/Source/JSONValidator.h"
 #include "_internal/Source/JSONWorker.h"
@@ -54,6 +57,18 @@ namespace libjson {
         return JSONWorker::RemoveWhiteSpaceAndComments(json, false);
     }
 
+    /**
+     * @brief Removes the whitespace from the JSON text.
+     *
+     * @param json  The text to strip whitespace from, it does not need to be null terminated.
+     * @param len   The length of the text.
+     *
+     * @return A copy of the text without any excess whitespace.
+     */
+    inline json_string strip_white_space(const json_char* json, size_t len) json_nothrow {
+        return JSONWorker::RemoveWhiteSpaceAndComments(json, len, false);
+    }
+
 #   ifndef JSON_STRING_HEADER
         /**
          * @brief Copies the given string into a `std::string`.
@@ -136,6 +151,30 @@ namespace libjson {
 #           endif
         }
 
+        /**
+         * @brief Parses the given text and returns a `JSONNode`.
+         *
+         * The text is read straight out of the caller's memory, so there is no need to
+         * copy it into a `json_string` first.  Nothing past `json + len` is looked at, so
+         * it does not need to be null terminated.
+         *
+         * @param json  The text to parse as JSON.
+         * @param len   The length of the text.
+         *
+         * @throws std::invalid_argument If the text contains invalid JSON.
+         *
+         * @return JSONNode The root element of the JSON document in the given text.
+         */
+        inline JSONNode parse(const json_char* json, size_t len) json_throws(std::invalid_argument) {
+#           ifdef JSON_PREPARSE
+                size_t stripped;
+                json_auto<json_char> buffer(JSONWorker::RemoveWhiteSpace(json, len, stripped, false));
+                return JSONPreparse::isValidRoot(json_string(buffer.ptr, stripped));
+#           else
+                return JSONWorker::parse(json, len);
+#           endif
+        }
+
         /**
          * @brief Parses the given string and returns a `JSONNode`.
          *
@@ -158,6 +197,220 @@ namespace libjson {
 #           endif
         }
 
+        /**
+         * @brief Parses the given text and returns a `JSONNode`.
+         *
+         * This method assumes there is no excess white space around the JSON.  The text is
+         * copied once, straight into the document, and nothing past `json + len` is looked
+         * at.
+         *
+         * @param json  The text to parse as JSON.
+         * @param len   The length of the text.
+         *
+         * @throws std::invalid_argument If the text contains invalid JSON.
+         *
+         * @return JSONNode The root element of the JSON document in the given text.
+         */
+        inline static JSONNode parse_unformatted(const json_char* json, size_t len)
+            json_throws(std::invalid_argument)
+        {
+#           ifdef JSON_PREPARSE
+                return JSONPreparse::isValidRoot(json_string(json, len));
+#           else
+                return JSONWorker::parse_unformatted(json, len);
+#           endif
+        }
+
+#       ifdef JSON_STRING_VIEW
+            /**
+             * @brief Parses the JSON in the given view, see `parse(const json_char*, size_t)`.
+             */
+            inline JSONNode parse(json_string_view json) json_throws(std::invalid_argument) {
+                return parse(json.data(), json.length());
+            }
+
+            /**
+             * @brief Parses a null terminated string, needed so literals aren't ambiguous.
+             */
+            inline JSONNode parse(const json_char* json) json_throws(std::invalid_argument) {
+                return parse(json, json_strlen(json));
+            }
+
+            /**
+             * @brief Parses the JSON in the given view, see `parse_unformatted(const json_char*, size_t)`.
+             */
+            inline static JSONNode parse_unformatted(json_string_view json)
+                json_throws(std::invalid_argument)
+            {
+                return parse_unformatted(json.data(), json.length());
+            }
+
+            /**
+             * @brief Parses a null terminated string, needed so literals aren't ambiguous.
+             */
+            inline static JSONNode parse_unformatted(const json_char* json)
+                json_throws(std::invalid_argument)
+            {
+                return parse_unformatted(json, json_strlen(json));
+            }
+#       endif
+
+        /**
+         * @brief Parses JSON that is sitting in a buffer that the caller owns, without copying it.
+         *
+         * White space and comments are stripped out of the buffer in place, and the
+         * returned tree points into it, so the buffer must stay alive and untouched for as
+         * long as the tree or any node that came from it is around.  Like every other string
+         * that libjson parses, `buf[len]` must exist and be a null terminator, it may be
+         * written over.
+         *
+         * @param buf The JSON to parse, it is overwritten.
+         * @param len The length of the JSON, not counting the null terminator.
+         *
+         * @throws std::invalid_argument If the buffer contains invalid JSON.
+         *
+         * @return JSONNode The root element of the JSON document in the given buffer.
+         */
+        inline JSONNode parse_insitu(json_char * buf, size_t len) json_throws(std::invalid_argument) {
+#           ifdef JSON_PREPARSE
+                return parse(json_string(buf, len));  //preparsing copies everything out of the text anyway
+#           else
+                return JSONWorker::parse_insitu(buf, len);
+#           endif
+        }
+
+        /**
+         * @brief Parses the given text and fully parses every value in it, using several threads.
+         *
+         * The top level array or object is split up on the calling thread, then its children
+         * are parsed at the same time, see `JSONNode::preparse_parallel`.  This is only worth it
+         * for large documents, everything else should use `parse`.
+         *
+         * @param json      The text to parse as JSON, it does not need to be null terminated.
+         * @param len       The length of the text.
+         * @param threads   How many threads to use, 0 uses one for every processor.
+         *
+         * @throws std::invalid_argument If the text contains invalid JSON.
+         *
+         * @return JSONNode The root element of the JSON document, already fully parsed.
+         */
+        inline JSONNode parse_parallel(const json_char* json, size_t len, unsigned int threads = 0) json_throws(std::invalid_argument) {
+#           ifdef JSON_PREPARSE
+                (void)threads;
+                return parse(json, len);  //preparsing already parsed everything
+#           else
+                JSONNode res(JSONWorker::parse(json, len));
+                res.preparse_parallel(threads);
+                return res;
+#           endif
+        }
+
+        /**
+         * @brief Parses the given string using several threads, see `parse_parallel(const json_char*, size_t, unsigned int)`.
+         */
+        inline JSONNode parse_parallel(const json_string& json, unsigned int threads = 0) json_throws(std::invalid_argument) {
+            return parse_parallel(json.data(), json.length(), threads);
+        }
+
+        /**
+         * @brief Gets the value that a JSON pointer (RFC 6901) refers to, without parsing the rest.
+         *
+         * Everything that isn't on the way to the value is skipped over by matching brackets
+         * and quotes, so nothing but the value itself is ever turned into a node.  This makes
+         * pulling one field out of a large document cost about as much as reading the text in
+         * front of it.
+         *
+         * @param json      The text to look through, it does not need to be null terminated.
+         * @param len       The length of the text.
+         * @param pointer   The JSON pointer, such as `/user/profile/id`, an empty one is the whole document.
+         *
+         * @throws std::out_of_range If there is nothing at the pointer.
+         * @throws std::invalid_argument If the pointer is malformed, or the text on the way to the
+         *                               value is not valid JSON.
+         *
+         * @return JSONNode The value that the pointer refers to.
+         */
+        inline JSONNode extract(const json_char* json, size_t len, const json_string& pointer) json_throws(std::logic_error) {
+            return JSONWorker::extract(json, len, pointer, 0);
+        }
+
+        /**
+         * @brief Gets the value that a JSON pointer refers to, see `extract(const json_char*, size_t, const json_string&)`.
+         */
+        inline JSONNode extract(const json_string& json, const json_string& pointer) json_throws(std::logic_error) {
+            return JSONWorker::extract(json.data(), json.length(), pointer, 0);
+        }
+
+        /**
+         * @brief Parses the given string into a flat, read only `JSONDocument`.
+         *
+         * The whole document is kept in one contiguous tape instead of a tree of nodes, which
+         * is much cheaper to build and to read when nothing is going to be changed.  Use
+         * `JSONElement::to_node` to get a `JSONNode` out of any part of it.
+         *
+         * @param json The string to parse as JSON.
+         *
+         * @throws std::invalid_argument If the string contains invalid JSON.
+         *
+         * @return JSONDocument The parsed document, `root()` is the top level element.
+         */
+        inline JSONDocument parse_document(const json_string& json) json_throws(std::invalid_argument) {
+            return JSONDocument(json);
+        }
+
+        /**
+         * @brief Parses the given text into a flat, read only `JSONDocument`.
+         *
+         * @param json  The text to parse as JSON, it does not need to be null terminated.
+         * @param len   The length of the text.
+         *
+         * @throws std::invalid_argument If the text contains invalid JSON.
+         *
+         * @return JSONDocument The parsed document, `root()` is the top level element.
+         */
+        inline JSONDocument parse_document(const json_char* json, size_t len) json_throws(std::invalid_argument) {
+            return JSONDocument(json, len);
+        }
+
+        /**
+         * @brief Parses the given text without building anything, reporting what it finds to a handler.
+         *
+         * The handler gets `start_object`, `key`, `end_object`, `start_array`, `end_array`,
+         * `string`, `number`, `boolean` and `null` calls in document order, see `JSONSax` for
+         * their signatures.  Any of them can return false to stop parsing early.
+         *
+         * @param json      The text to parse, it does not need to be null terminated.
+         * @param len       The length of the text.
+         * @param handler   The object that is told about every value.
+         *
+         * @return True if the whole text was valid JSON and the handler never stopped it.
+         */
+        template<class Handler>
+        inline bool parse_sax(const json_char* json, size_t len, Handler& handler) json_nothrow {
+#           ifdef JSON_SECURITY_MAX_STRING_LENGTH
+                if (json_unlikely(len > JSON_SECURITY_MAX_STRING_LENGTH)){
+                   JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+                   return false;
+                }
+#           endif
+            json_auto<json_char> s;
+            s.set(JSONWorker::RemoveWhiteSpaceAndCommentsC(json, len, false));
+            return JSONSax<Handler>(handler).parse(s.ptr);
+        }
+
+        /**
+         * @brief Parses the given string without building anything, reporting what it finds to a handler.
+         *
+         * @param json      The string to parse.
+         * @param handler   The object that is told about every value.
+         *
+         * @return True if the whole string was valid JSON and the handler never stopped it.
+         */
+        template<class Handler>
+        inline bool parse_sax(const json_string& json, Handler& handler) json_nothrow {
+            return parse_sax(json.data(), json.length(), handler);
+        }
+
 #       ifdef JSON_VALIDATE
             /**
              * @brief Checks that the given JSON string contains validly formatted data.
@@ -197,6 +450,81 @@ namespace libjson {
 #               endif
                 return JSONValidator::isValidRoot(json.c_str());
             }
+
+            /**
+             * @brief Checks that the given text contains validly formatted data.
+             *
+             * Nothing past `json + len` is looked at, so the text does not need to be null
+             * terminated.
+             *
+             * @param json  The JSON text to check.
+             * @param len   The length of the text.
+             *
+             * @return True if the given text contains valid JSON.
+             */
+            inline bool is_valid(const json_char* json, size_t len) json_nothrow {
+#               ifdef JSON_SECURITY_MAX_STRING_LENGTH
+                    if (json_unlikely(len > JSON_SECURITY_MAX_STRING_LENGTH)){
+                       JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+                       return false;
+                    }
+#               endif
+                json_auto<json_char> s;
+                s.set(JSONWorker::RemoveWhiteSpaceAndCommentsC(json, len, false));
+                return JSONValidator::isValidRoot(s.ptr);
+            }
+
+            /**
+             * @brief Checks that the given text contains validly formatted data.
+             *
+             * This method assumes there is no excess white space around the JSON.  The text
+             * is validated where it is, without being copied, and nothing past `json + len`
+             * is looked at.
+             *
+             * @param json  The JSON text to check.
+             * @param len   The length of the text.
+             *
+             * @return True if the given text contains valid JSON.
+             */
+            inline static bool is_valid_unformatted(const json_char* json, size_t len) json_nothrow {
+#               ifdef JSON_SECURITY_MAX_STRING_LENGTH
+                    if (json_unlikely(len > JSON_SECURITY_MAX_STRING_LENGTH)){
+                       JSON_FAIL(JSON_TEXT("Exceeding JSON_SECURITY_MAX_STRING_LENGTH"));
+                       return false;
+                    }
+#               endif
+                return JSONValidator::isValidRoot(json, len);
+            }
+
+#           ifdef JSON_STRING_VIEW
+                /**
+                 * @brief Checks the JSON in the given view, see `is_valid(const json_char*, size_t)`.
+                 */
+                inline bool is_valid(json_string_view json) json_nothrow {
+                    return is_valid(json.data(), json.length());
+                }
+
+                /**
+                 * @brief Checks a null terminated string, needed so literals aren't ambiguous.
+                 */
+                inline bool is_valid(const json_char* json) json_nothrow {
+                    return is_valid(json, json_strlen(json));
+                }
+
+                /**
+                 * @brief Checks the JSON in the given view, see `is_valid_unformatted(const json_char*, size_t)`.
+                 */
+                inline static bool is_valid_unformatted(json_string_view json) json_nothrow {
+                    return is_valid_unformatted(json.data(), json.length());
+                }
+
+                /**
+                 * @brief Checks a null terminated string, needed so literals aren't ambiguous.
+                 */
+                inline static bool is_valid_unformatted(const json_char* json) json_nothrow {
+                    return is_valid_unformatted(json, json_strlen(json));
+                }
+#           endif
 #       endif // JSON_VALIDATE
 #   endif // JSON_READ_PRIORITY
 